@@ -0,0 +1,48 @@
+"""
+Measures the cycles taken by the delay extension to send the delayed spikes
+of each time step when 1%, 10% and 100% of its neurons are active.  Only the
+neurons which received spikes in the slot of each delay stage are visited, so
+the cycles should follow the activity rather than the number of neurons.
+
+This needs a machine.  Build the delay extension binary with
+PROFILER=PROFILER_ENABLED and run this script; to compare against the
+implementation which visits every neuron, build and run again at the
+previous version.  For each activity (printed by this script), the
+Timer_callback phase of the profile in the provenance data of the delay
+extension of the source population gives the cycles taken per time step.
+"""
+import spynnaker.pyNN as p
+
+ACTIVITIES = [0.01, 0.1, 1.0]
+DELAYS = [20.0, 40.0, 60.0, 80.0, 100.0, 120.0, 140.0]
+
+
+def run_benchmark(n_neurons=256, activity=0.1, rate=50.0, run_time=10000):
+    p.setup(timestep=1.0, min_delay=1.0, max_delay=144.0)
+
+    # Only the first activity * n_neurons sources spike
+    n_active = max(1, int(round(activity * n_neurons)))
+    rates = [rate] * n_active + [0.0] * (n_neurons - n_active)
+    source = p.Population(
+        n_neurons, p.SpikeSourcePoisson, {"rate": rates}, label="source")
+    target = p.Population(n_neurons, p.IF_curr_exp, {}, label="target")
+
+    # Each delay longer than the target supports itself is in a different
+    # delay stage, so every active neuron is sent from each of those stages
+    for delay in DELAYS:
+        p.Projection(
+            source, target, p.OneToOneConnector(weights=0.1, delays=delay),
+            target="excitatory")
+
+    p.run(run_time)
+    p.end()
+
+    print "{} of {} neurons active at {} Hz, delays of {}".format(
+        n_active, n_neurons, rate, DELAYS)
+    print "Compare Timer_callback Mean_cycles of the delay extension of {}"\
+        " in the provenance data".format(source.label)
+
+
+if __name__ == "__main__":
+    for fraction in ACTIVITIES:
+        run_benchmark(activity=fraction)
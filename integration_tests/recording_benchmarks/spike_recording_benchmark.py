@@ -0,0 +1,84 @@
+"""
+Compares the size and extraction time of the adaptive spike recording format
+(a bit field or a list of indices, whichever is smaller) against the original
+format of a full bit field for every time step in which a neuron spiked.
+
+The recordings are synthesised on the host in the format written by
+out_spikes_record, so no machine is needed.
+"""
+import struct
+import time
+import numpy
+
+from spynnaker.pyNN.models.common.spike_recorder import decode_spike_records
+
+
+def _bit_field_format(spikes, n_words):
+    """ The original format: time, then the bit field
+    """
+    data = list()
+    for tick in range(spikes.shape[0]):
+        bit_field = numpy.packbits(
+            spikes[tick].reshape((-1, 32))[:, ::-1]).view(">u4")
+        if bit_field.any():
+            data.append(struct.pack("<I", tick))
+            data.append(bit_field.astype("<u4").tostring())
+    return bytearray("".join(data))
+
+
+def _adaptive_format(spikes, n_words):
+    """ The adaptive format: time, header, then bit field or indices
+    """
+    data = list()
+    for tick in range(spikes.shape[0]):
+        indices = numpy.flatnonzero(spikes[tick])
+        if len(indices) == 0:
+            continue
+        if len(indices) >= n_words * 2:
+            bit_field = numpy.packbits(
+                spikes[tick].reshape((-1, 32))[:, ::-1]).view(">u4")
+            data.append(struct.pack("<II", tick, n_words))
+            data.append(bit_field.astype("<u4").tostring())
+        else:
+            data.append(struct.pack("<II", tick, 0x80000000 | len(indices)))
+            if len(indices) % 2 == 1:
+                indices = numpy.append(indices, 0)
+            data.append(indices.astype("<u2").tostring())
+    return bytearray("".join(data))
+
+
+def _decode_bit_field_format(raw, n_words):
+    raw_data = numpy.asarray(raw, dtype="uint8").view(
+        dtype="<i4").reshape([-1, n_words + 1])
+    split_record = numpy.array_split(raw_data, [1, 1], 1)
+    spikes = split_record[2].byteswap().view("uint8")
+    bits = numpy.fliplr(numpy.unpackbits(spikes).reshape(
+        (-1, 32))).reshape((-1, n_words * 32))
+    time_indices, indices = numpy.where(bits == 1)
+    return split_record[0][time_indices].reshape((-1)), indices
+
+
+def run_benchmark(n_neurons=256, n_ticks=10000, rates=(1, 5, 20, 100, 500)):
+    n_words = int(numpy.ceil(n_neurons / 32.0))
+    rng = numpy.random.RandomState(42)
+    print "{:>8} {:>12} {:>12} {:>10} {:>10}".format(
+        "rate Hz", "old bytes", "new bytes", "old s", "new s")
+    for rate in rates:
+        spikes = rng.random_sample((n_ticks, n_words * 32)) < rate / 1000.0
+        spikes[:, n_neurons:] = False
+        old = _bit_field_format(spikes, n_words)
+        new = _adaptive_format(spikes, n_words)
+
+        start = time.time()
+        _decode_bit_field_format(old, n_words)
+        old_time = time.time() - start
+        start = time.time()
+        decode_spike_records(new, n_words)
+        new_time = time.time() - start
+
+        print "{:>8} {:>12} {:>12} {:>10.4f} {:>10.4f}".format(
+            rate, len(old), len(new), old_time, new_time)
+
+
+if __name__ == "__main__":
+    run_benchmark()
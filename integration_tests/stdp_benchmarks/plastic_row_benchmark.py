@@ -0,0 +1,57 @@
+"""
+Compares the cycles taken to process plastic rows by the MAD STDP
+implementation when the plastic synapses are processed one at a time (the
+default) and in pairs, loading and storing the control words and weights of
+each pair as single words.
+
+This needs a machine.  Build the neuron binaries twice with
+PROFILER=PROFILER_ENABLED, once as normal and once with
+PLASTIC_SYNAPSE_LOADS=PLASTIC_SYNAPSE_LOADS_PAIRED, and run this script with
+each.  The DMA_row_processing phase of the profile in the provenance data of
+the post-synaptic population gives the cycles taken per row; dividing the
+Mean_cycles by the number of synapses per row (printed by this script) gives
+the cycles per synapse.
+"""
+import spynnaker.pyNN as p
+
+
+def run_benchmark(
+        n_pre=256, n_post=256, pre_rate=10.0, post_rate=10.0,
+        run_time=10000):
+    p.setup(timestep=1.0, min_delay=1.0, max_delay=14.0)
+
+    pre_pop = p.Population(
+        n_pre, p.SpikeSourcePoisson, {"rate": pre_rate}, label="pre")
+    post_driver = p.Population(
+        n_post, p.SpikeSourcePoisson, {"rate": post_rate},
+        label="post_driver")
+    post_pop = p.Population(n_post, p.IF_curr_exp, {}, label="post")
+
+    # Drive the post-synaptic neurons strongly enough that they spike at
+    # about the rate of their drivers
+    p.Projection(
+        post_driver, post_pop, p.OneToOneConnector(weights=5.0, delays=1.0),
+        target="excitatory")
+
+    # Every row of the plastic projection has n_post synapses
+    stdp_model = p.STDPMechanism(
+        timing_dependence=p.SpikePairRule(tau_plus=20.0, tau_minus=20.0),
+        weight_dependence=p.AdditiveWeightDependence(
+            w_min=0.0, w_max=0.1, A_plus=0.001, A_minus=0.001),
+        mad=True)
+    p.Projection(
+        pre_pop, post_pop, p.AllToAllConnector(weights=0.05, delays=1.0),
+        synapse_dynamics=p.SynapseDynamics(slow=stdp_model),
+        target="excitatory")
+
+    p.run(run_time)
+    p.end()
+
+    print "Plastic rows of {} synapses, {} Hz pre-synaptic rate".format(
+        n_post, pre_rate)
+    print "Compare DMA_row_processing Mean_cycles of {} in the provenance"\
+        " data".format(post_pop.label)
+
+
+if __name__ == "__main__":
+    run_benchmark()
@@ -0,0 +1,62 @@
+"""
+Measures the cycles taken to process plastic rows by the MAD STDP
+implementation over a range of post-synaptic firing rates.  At low rates most
+pre-synaptic spikes find no post-synaptic spikes in their window and nothing
+to depress, so the synapses take the fast path which leaves the synaptic word
+as it is; as the rate rises, more of them go through the full update.
+
+This needs a machine.  Build the neuron binaries with
+PROFILER=PROFILER_ENABLED and run this script; to compare against the
+implementation without the fast path, build and run again at the previous
+version.  For each post-synaptic rate (printed by this script), the
+DMA_row_processing phase of the profile in the provenance data of the
+post-synaptic population gives the cycles taken per row; dividing the
+Mean_cycles by the number of synapses per row gives the cycles per synapse.
+"""
+import spynnaker.pyNN as p
+
+POST_RATES = [0.0, 1.0, 5.0, 10.0, 20.0, 50.0]
+
+
+def run_benchmark(
+        n_pre=256, n_post=256, pre_rate=10.0, post_rate=10.0,
+        run_time=10000):
+    p.setup(timestep=1.0, min_delay=1.0, max_delay=14.0)
+
+    pre_pop = p.Population(
+        n_pre, p.SpikeSourcePoisson, {"rate": pre_rate}, label="pre")
+    post_driver = p.Population(
+        n_post, p.SpikeSourcePoisson, {"rate": post_rate},
+        label="post_driver")
+    post_pop = p.Population(n_post, p.IF_curr_exp, {}, label="post")
+
+    # Drive the post-synaptic neurons strongly enough that they spike at
+    # about the rate of their drivers
+    p.Projection(
+        post_driver, post_pop, p.OneToOneConnector(weights=5.0, delays=1.0),
+        target="excitatory")
+
+    # The plastic weights are too small to make the post-synaptic neurons
+    # spike by themselves, so the post-synaptic rate is that of the drivers
+    stdp_model = p.STDPMechanism(
+        timing_dependence=p.SpikePairRule(tau_plus=20.0, tau_minus=20.0),
+        weight_dependence=p.AdditiveWeightDependence(
+            w_min=0.0, w_max=0.1, A_plus=0.001, A_minus=0.001),
+        mad=True)
+    p.Projection(
+        pre_pop, post_pop, p.AllToAllConnector(weights=0.05, delays=1.0),
+        synapse_dynamics=p.SynapseDynamics(slow=stdp_model),
+        target="excitatory")
+
+    p.run(run_time)
+    p.end()
+
+    print "Plastic rows of {} synapses, {} Hz post-synaptic rate".format(
+        n_post, post_rate)
+    print "Compare DMA_row_processing Mean_cycles of {} in the provenance"\
+        " data".format(post_pop.label)
+
+
+if __name__ == "__main__":
+    for rate in POST_RATES:
+        run_benchmark(post_rate=rate)
@@ -34,6 +34,10 @@ static inline bool in_spikes_is_next_spike_equal(spike_t spike) {
     return circular_buffer_advance_if_next_equals(buffer, spike);
 }
 
+static inline uint32_t in_spikes_size() {
+    return circular_buffer_size(buffer);
+}
+
 static inline counter_t in_spikes_get_n_buffer_overflows() {
     return circular_buffer_get_n_buffer_overflows(buffer);
 }
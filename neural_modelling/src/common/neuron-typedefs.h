@@ -95,5 +95,13 @@ typedef struct timed_state_t {
     state_t states[];
 } timed_state_t;
 
+//! State recorded as 16-bit differences from the lowest state in the time
+//! step, each shifted right to trade precision for range
+typedef struct timed_compressed_state_t {
+    uint32_t time;
+    state_t baseline;
+    uint16_t deltas[];
+} timed_compressed_state_t;
+
 
 #endif /* __NEURON_TYPEDEFS_H__ */
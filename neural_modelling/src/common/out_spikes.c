@@ -8,16 +8,37 @@
 
 #include <debug.h>
 
+//! The top bit of the record header is set if the record holds a list of
+//! spike indices rather than a bit field
+#define SPARSE_RECORD_FLAG 0x80000000
+
 // Globals
+//! A record holding the full bit field of spikes for a time step; the header
+//! is the number of words in the bit field
 typedef struct timed_out_spikes{
     uint32_t time;
+    uint32_t header;
     uint32_t out_spikes[];
 } timed_out_spikes;
 
+//! A record holding the indices of the spike sources which spiked in a time
+//! step; the header is SPARSE_RECORD_FLAG | the number of indices, and the
+//! indices are padded to a whole number of words
+typedef struct timed_out_spike_indices{
+    uint32_t time;
+    uint32_t header;
+    uint16_t indices[];
+} timed_out_spike_indices;
+
 static timed_out_spikes *spikes;
+static timed_out_spike_indices *spike_indices;
 bit_field_t out_spikes;
 static size_t out_spikes_size;
 
+//! The number of spikes below which the list of indices is smaller than the
+//! bit field
+static uint32_t max_sparse_spikes;
+
 
 //! \brief clears the currently recorded spikes
 void out_spikes_reset() {
@@ -37,7 +58,18 @@ bool out_spikes_initialize(size_t max_spike_sources) {
         log_error("Out of DTCM when allocating out_spikes");
         return false;
     }
+    spikes->header = out_spikes_size;
     out_spikes = &(spikes->out_spikes[0]);
+
+    // The list of indices is only used when it is smaller than the bit field,
+    // so it never needs more words than the bit field does
+    max_sparse_spikes = out_spikes_size * 2;
+    spike_indices = (timed_out_spike_indices *) spin1_malloc(
+        sizeof(timed_out_spike_indices) + (out_spikes_size * sizeof(uint32_t)));
+    if (spike_indices == NULL) {
+        log_error("Out of DTCM when allocating out_spikes indices");
+        return false;
+    }
     out_spikes_reset();
     return true;
 }
@@ -48,11 +80,47 @@ bool out_spikes_initialize(size_t max_spike_sources) {
 //! \param[in] time The time at which the recording is being made
 void out_spikes_record(uint8_t channel, uint32_t time) {
 
-    // copy out-spikes to the appropriate recording channel
-    if (!out_spikes_is_empty()) {
+    // Count the spikes, stopping as soon as the bit field is known to be the
+    // smaller encoding
+    uint32_t n_spikes = 0;
+    for (index_t i = 0; i < out_spikes_size; i++) {
+        n_spikes += __builtin_popcount(out_spikes[i]);
+        if (n_spikes >= max_sparse_spikes) {
+            break;
+        }
+    }
+
+    if (n_spikes == 0) {
+        return;
+    }
+
+    if (n_spikes >= max_sparse_spikes) {
+
+        // copy out-spikes to the appropriate recording channel
         spikes->time = time;
         recording_record(
-            channel, spikes, (out_spikes_size + 1) * sizeof(uint32_t));
+            channel, spikes, (out_spikes_size + 2) * sizeof(uint32_t));
+    } else {
+
+        // Write the index of each set bit, lowest first
+        uint16_t *indices = spike_indices->indices;
+        for (index_t i = 0; i < out_spikes_size; i++) {
+            uint32_t bits = out_spikes[i];
+            while (bits != 0) {
+                *indices++ = (uint16_t) ((i << 5) + __builtin_ctz(bits));
+                bits &= bits - 1;
+            }
+        }
+        if (n_spikes & 0x1) {
+            *indices = 0;
+        }
+
+        spike_indices->time = time;
+        spike_indices->header = SPARSE_RECORD_FLAG | n_spikes;
+        recording_record(
+            channel, spike_indices,
+            sizeof(timed_out_spike_indices) +
+            (((n_spikes + 1) >> 1) * sizeof(uint32_t)));
     }
 }
 
@@ -15,8 +15,11 @@
  *          records the current set of flags for each spike source into the
  *          spike recording region in SDRAM (flags to deduce which regions are
  *           active are handed to this method due to recording not containing
- *           them itself). TODO change the recording.h and recording.c to
- *           contain the channels itself.
+ *           them itself). Each record is a time, a header word and either the
+ *           bit field of flags or, if it is smaller, a list of 16-bit indices
+ *           of the sources that spiked (marked by the top bit of the header).
+ *           TODO change the recording.h and recording.c to contain the
+ *           channels itself.
  *     - out_spikes_is_empty
  *          helper method which checks if the current spikes flags have any
  *          recorded for use.
@@ -50,7 +53,8 @@ void out_spikes_reset();
 bool out_spikes_initialize(size_t max_spike_sources);
 
 //! \brief flush the recorded spikes - must be called to do the actual
-//!        recording
+//!        recording.  The spikes are written either as a bit field or as a
+//!        list of indices, whichever is the smaller
 //! \param[in] channel The channel to record to
 //! \param[in] time The time at which the recording is being made
 void out_spikes_record(uint8_t channel, uint32_t time);
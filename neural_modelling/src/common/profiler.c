@@ -0,0 +1,75 @@
+/*! \file
+ *
+ *  \brief the implementation of the profiler.h interface.
+ */
+
+#include "profiler.h"
+
+#include <debug.h>
+
+#ifdef PROFILER_ENABLED
+
+// Globals
+profiler_phase_stats_t profiler_phase_stats[PROFILER_N_PHASES];
+uint32_t profiler_phase_start[PROFILER_N_PHASES];
+uint32_t profiler_bin_width;
+
+//! The timer period in clock cycles
+static uint32_t timer_period_cycles;
+
+void profiler_initialise(uint32_t timer_period) {
+    timer_period_cycles = timer_period * sv->cpu_clk;
+    profiler_bin_width = timer_period_cycles / PROFILER_N_BINS;
+
+    for (uint32_t p = 0; p < PROFILER_N_PHASES; p++) {
+        profiler_phase_stats_t *stats = &profiler_phase_stats[p];
+        stats->n_samples = 0;
+        stats->min_cycles = UINT32_MAX;
+        stats->max_cycles = 0;
+        stats->total_cycles = 0;
+        for (uint32_t b = 0; b < PROFILER_N_BINS; b++) {
+            stats->bins[b] = 0;
+        }
+    }
+
+    // Timer 2 is not used by the API, so run it as a free running 32-bit
+    // counter at the clock rate
+    tc[T2_CONTROL] = 0;
+    tc[T2_LOAD] = UINT32_MAX;
+    tc[T2_CONTROL] = 0x82;
+
+    log_info("Profiling enabled, timer period = %u cycles",
+             timer_period_cycles);
+}
+
+void profiler_store_provenance(address_t provenance_region) {
+    provenance_region[0] = PROFILER_N_PHASES;
+    provenance_region[1] = timer_period_cycles;
+    address_t data = &provenance_region[2];
+    for (uint32_t p = 0; p < PROFILER_N_PHASES; p++) {
+        profiler_phase_stats_t *stats = &profiler_phase_stats[p];
+        data[0] = stats->n_samples;
+        data[1] = (stats->n_samples > 0)? stats->min_cycles: 0;
+        data[2] = stats->max_cycles;
+        data[3] = (uint32_t) stats->total_cycles;
+        data[4] = (uint32_t) (stats->total_cycles >> 32);
+        for (uint32_t b = 0; b < PROFILER_N_BINS; b++) {
+            data[5 + b] = stats->bins[b];
+        }
+        data += PROFILER_WORDS_PER_PHASE;
+    }
+}
+
+#else // PROFILER_ENABLED
+
+void profiler_initialise(uint32_t timer_period) {
+    use(timer_period);
+}
+
+void profiler_store_provenance(address_t provenance_region) {
+
+    // No phases have been profiled
+    provenance_region[0] = 0;
+}
+
+#endif // PROFILER_ENABLED
@@ -0,0 +1,116 @@
+/*! \file
+ *
+ *  \brief utility which measures the number of clock cycles spent in each
+ *   phase of processing, when compiled with PROFILER_ENABLED
+ *
+ *  \details The API includes:
+ *     - profiler_initialise
+ *          starts the free running timer used to measure cycles and clears
+ *          the statistics of each phase
+ *     - profiler_start
+ *          marks the start of a phase
+ *     - profiler_end
+ *          marks the end of a phase, adding the cycles since the start of the
+ *          phase to its minimum, maximum, total and histogram
+ *     - profiler_store_provenance
+ *          writes the statistics of each phase into the provenance region
+ *
+ *   If PROFILER_ENABLED is not defined, profiler_start and profiler_end do
+ *   nothing and profiler_store_provenance records that there are no phases.
+ */
+
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+#include <common-typedefs.h>
+#include <sark.h>
+
+//! The phases of processing that are profiled
+typedef enum profiler_phase {
+    PROFILER_TIMER, PROFILER_SYNAPSE_TRANSFER, PROFILER_NEURON_UPDATE,
+    PROFILER_RECORDING, PROFILER_DMA_ROW, PROFILER_N_PHASES
+} profiler_phase;
+
+//! The number of bins in the histogram of each phase; each bin covers an
+//! equal fraction of the timer period, with the last bin also counting any
+//! phases that took longer than the timer period
+#define PROFILER_N_BINS 8
+
+//! The statistics gathered for each phase
+typedef struct profiler_phase_stats_t {
+    uint32_t n_samples;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+    uint32_t bins[PROFILER_N_BINS];
+} profiler_phase_stats_t;
+
+//! The number of words written to provenance for each phase
+#define PROFILER_WORDS_PER_PHASE (5 + PROFILER_N_BINS)
+
+//! The number of words written to provenance: the number of phases, the
+//! timer period in cycles and then the statistics of each phase
+#define PROFILER_PROVENANCE_WORDS \
+    (2 + (PROFILER_N_PHASES * PROFILER_WORDS_PER_PHASE))
+
+#ifdef PROFILER_ENABLED
+
+extern profiler_phase_stats_t profiler_phase_stats[PROFILER_N_PHASES];
+extern uint32_t profiler_phase_start[PROFILER_N_PHASES];
+extern uint32_t profiler_bin_width;
+
+//! \brief marks the start of a phase
+//! \param[in] phase The phase that is starting
+static inline void profiler_start(profiler_phase phase) {
+    profiler_phase_start[phase] = tc[T2_COUNT];
+}
+
+//! \brief marks the end of a phase and updates its statistics
+//! \param[in] phase The phase that is ending
+static inline void profiler_end(profiler_phase phase) {
+
+    // The timer counts down
+    uint32_t cycles = profiler_phase_start[phase] - tc[T2_COUNT];
+    profiler_phase_stats_t *stats = &profiler_phase_stats[phase];
+
+    stats->n_samples++;
+    stats->total_cycles += cycles;
+    if (cycles < stats->min_cycles) {
+        stats->min_cycles = cycles;
+    }
+    if (cycles > stats->max_cycles) {
+        stats->max_cycles = cycles;
+    }
+
+    uint32_t bin = 0;
+    uint32_t bin_end = profiler_bin_width;
+    while (bin < (PROFILER_N_BINS - 1) && cycles >= bin_end) {
+        bin++;
+        bin_end += profiler_bin_width;
+    }
+    stats->bins[bin]++;
+}
+
+#else // PROFILER_ENABLED
+
+static inline void profiler_start(profiler_phase phase) {
+    use(phase);
+}
+
+static inline void profiler_end(profiler_phase phase) {
+    use(phase);
+}
+
+#endif // PROFILER_ENABLED
+
+//! \brief starts the cycle timer and clears the statistics
+//! \param[in] timer_period The timer period in microseconds, used to scale
+//!            the histograms
+void profiler_initialise(uint32_t timer_period);
+
+//! \brief writes the statistics into the provenance region
+//! \param[in] provenance_region The address at which to write the
+//!            PROFILER_PROVENANCE_WORDS words of statistics
+void profiler_store_provenance(address_t provenance_region);
+
+#endif // _PROFILER_H_
@@ -1,5 +1,6 @@
 #include "../common/neuron-typedefs.h"
 #include "../common/in_spikes.h"
+#include "../common/profiler.h"
 
 #include <bit_field.h>
 #include <data_specification.h>
@@ -23,9 +24,18 @@ typedef enum region_identifiers{
 } region_identifiers;
 
 enum parameter_positions {
-    KEY, INCOMING_KEY, INCOMING_MASK, N_ATOMS, N_DELAY_STAGES, DELAY_BLOCKS
+    KEY, INCOMING_KEY, INCOMING_MASK, N_ATOMS, N_DELAY_STAGES,
+    TIMESTEPS_PER_TICK, INCOMING_SPIKE_BUFFER_SIZE, DELAY_BLOCKS
 };
 
+//! entries in the provenance data region after the common entries
+typedef enum extra_provenance_data_region_entries{
+    N_BUFFER_OVERFLOWS = 0,
+    N_COUNTER_SATURATIONS = 1,
+    N_INVALID_KEYS = 2,
+    PROFILER_DATA_START = 3
+} extra_provenance_data_region_entries;
+
 // Globals
 static uint32_t key = 0;
 static uint32_t incoming_key = 0;
@@ -35,8 +45,11 @@ static uint32_t num_neurons = 0;
 static uint32_t time = UINT32_MAX;
 static uint32_t simulation_ticks = 0;
 static uint32_t infinite_run;
+static uint32_t timesteps_per_tick = 1;
+static uint32_t incoming_spike_buffer_size = 0;
 
 static uint8_t **spike_counters = NULL;
+static bit_field_t *spike_slot_active = NULL;
 static bit_field_t *neuron_delay_stage_config = NULL;
 static uint32_t num_delay_stages = 0;
 static uint32_t num_delay_slots_mask = 0;
@@ -44,6 +57,11 @@ static uint32_t neuron_bit_field_words = 0;
 
 static bool processing_spikes = false;
 
+// Counts of lost and discarded spikes, for provenance
+static uint32_t n_buffer_overflows = 0;
+static uint32_t n_counter_saturations = 0;
+static uint32_t n_invalid_keys = 0;
+
 static inline uint32_t round_to_next_pot(uint32_t v) {
     v--;
     v |= v >> 1;
@@ -72,16 +90,20 @@ static bool read_parameters(address_t address) {
     neuron_bit_field_words = get_bit_field_size(num_neurons);
 
     num_delay_stages = address[N_DELAY_STAGES];
+    timesteps_per_tick = address[TIMESTEPS_PER_TICK];
+    incoming_spike_buffer_size = address[INCOMING_SPIKE_BUFFER_SIZE];
     uint32_t num_delay_slots = num_delay_stages * DELAY_STAGE_LENGTH;
     uint32_t num_delay_slots_pot = round_to_next_pot(num_delay_slots);
     num_delay_slots_mask = (num_delay_slots_pot - 1);
 
     log_info("\t parrot neurons = %u, neuron bit field words = %u,"
              " num delay stages = %u, num delay slots = %u (pot = %u),"
-             " num delay slots mask = %08x",
+             " num delay slots mask = %08x, time steps per tick = %u,"
+             " incoming spike buffer size = %u",
              num_neurons, neuron_bit_field_words,
              num_delay_stages, num_delay_slots, num_delay_slots_pot,
-             num_delay_slots_mask);
+             num_delay_slots_mask, timesteps_per_tick,
+             incoming_spike_buffer_size);
 
     // Create array containing a bitfield specifying whether each neuron should
     // emit spikes after each delay stage
@@ -109,16 +131,30 @@ static bool read_parameters(address_t address) {
         }
     }
 
-    // Allocate array of counters for each delay slot
+    // Allocate array of counters for each delay slot, and a bit-field of
+    // the neurons whose counters are non-zero in each slot
     spike_counters = (uint8_t**) spin1_malloc(
         num_delay_slots_pot * sizeof(uint8_t*));
+    spike_slot_active = (bit_field_t*) spin1_malloc(
+        num_delay_slots_pot * sizeof(bit_field_t));
+    if (spike_counters == NULL || spike_slot_active == NULL) {
+        log_error("Unable to allocate delay slots");
+        return false;
+    }
 
     for (uint32_t s = 0; s < num_delay_slots_pot; s++) {
 
         // Allocate an array of counters for each neuron and zero
         spike_counters[s] = (uint8_t*) spin1_malloc(
             num_neurons * sizeof(uint8_t));
+        spike_slot_active[s] = (bit_field_t) spin1_malloc(
+            neuron_bit_field_words * sizeof(uint32_t));
+        if (spike_counters[s] == NULL || spike_slot_active[s] == NULL) {
+            log_error("Unable to allocate delay slot %u", s);
+            return false;
+        }
         memset(spike_counters[s], 0, num_neurons * sizeof(uint8_t));
+        clear_bit_field(spike_slot_active[s], neuron_bit_field_words);
     }
 
     log_info("read_parameters: completed successfully");
@@ -166,6 +202,8 @@ void incoming_spike_callback(uint key, uint payload) {
             processing_spikes = true;
             spin1_trigger_user_event(0, 0);
         }
+    } else {
+        n_buffer_overflows++;
     }
 }
 
@@ -182,12 +220,10 @@ void spike_process(uint unused0, uint unused1) {
     uint32_t current_time_slot = time & num_delay_slots_mask;
     uint8_t *current_time_slot_spike_counters =
         spike_counters[current_time_slot];
+    bit_field_t current_time_slot_active = spike_slot_active[current_time_slot];
 
     log_debug("Current time slot %u", current_time_slot);
 
-    // Zero all counters in current time slot
-    memset(current_time_slot_spike_counters, 0, sizeof(uint8_t) * num_neurons);
-
     // While there are any incoming spikes
     spike_t s;
     while (in_spikes_get_next_spike(&s)) {
@@ -198,95 +234,143 @@ void spike_process(uint unused0, uint unused1) {
             uint32_t neuron_id = _key_n(s);
             if (neuron_id < num_neurons) {
 
-                // Increment counter
-                current_time_slot_spike_counters[neuron_id]++;
+                // Mark the neuron as active in this slot on its first
+                // spike, and increment the counter (saturating, as a
+                // wrapped counter would both lose spikes and mark the
+                // neuron twice)
+                uint8_t count = current_time_slot_spike_counters[neuron_id];
+                if (count == 0) {
+                    bit_field_set(current_time_slot_active, neuron_id);
+                }
+                if (count < UINT8_MAX) {
+                    current_time_slot_spike_counters[neuron_id] = count + 1;
+                } else {
+                    n_counter_saturations++;
+                }
                 log_debug("Incrementing counter %u = %u\n", neuron_id,
                           current_time_slot_spike_counters[neuron_id]);
             } else {
                 log_debug("Invalid neuron ID %u", neuron_id);
+                n_invalid_keys++;
             }
         } else {
             log_debug("Invalid spike key 0x%08x", s);
+            n_invalid_keys++;
         }
     }
 
     processing_spikes = false;
 }
 
-void timer_callback(uint unused0, uint unused1) {
-    use(unused0);
-    use(unused1);
-
-    time++;
-
-    log_debug("Timer tick %u", time);
-
-    // If a fixed number of simulation ticks are specified and these have passed
-    if (infinite_run != TRUE && time >= simulation_ticks) {
-
-        // handle the pause and resume functionality
-        simulation_handle_pause_resume(NULL);
-
-        // Subtract 1 from the time so this tick gets done again on the next
-        // run
-        time -= 1;
-        return;
-    }
+//! \brief Sends the spikes due from each delay stage at the current time
+//!        and clears the counters of the current time slot
+//!
+//! Only the neurons which received spikes in the slot of each stage are
+//! visited; these are found a word at a time from the bit-field of active
+//! neurons of the slot masked by the configuration of the stage, so the cost
+//! follows the number of spikes rather than the number of neurons.
+static inline void _do_timestep_update() {
 
     // Loop through delay stages
     for (uint32_t d = 0; d < num_delay_stages; d++) {
 
-        // If any neurons emit spikes after this delay stage
+        // Get key mask for this delay stage and it's time slot
         bit_field_t delay_stage_config = neuron_delay_stage_config[d];
-        if (nonempty_bit_field(delay_stage_config, neuron_bit_field_words)) {
-
-            // Get key mask for this delay stage and it's time slot
-            uint32_t delay_stage_delay = (d + 1) * DELAY_STAGE_LENGTH;
-            uint32_t delay_stage_time_slot =
-                ((time - delay_stage_delay) & num_delay_slots_mask);
-            uint8_t *delay_stage_spike_counters =
-                spike_counters[delay_stage_time_slot];
-
-            log_debug("Checking time slot %u for delay stage %u",
-                      delay_stage_time_slot, d);
-
-            // Loop through neurons
-            for (uint32_t n = 0; n < num_neurons; n++) {
-
-                // If this neuron emits a spike after this stage
-                if (bit_field_test(delay_stage_config, n)) {
-
-                    // Calculate key all spikes coming from this neuron will be
-                    // sent with
-                    uint32_t spike_key = ((d * num_neurons) + n) + key;
-
-#if LOG_LEVEL >= LOG_DEBUG
-                    if (delay_stage_spike_counters[n] > 0) {
-                        log_debug("Neuron %u sending %u spikes after delay"
-                                  "stage %u with key %x",
-                                  n, delay_stage_spike_counters[n], d,
-                                  spike_key);
-                    }
-#endif  // DEBUG
-
-                    // Loop through counted spikes and send
-                    for (uint32_t s = 0; s < delay_stage_spike_counters[n];
-                            s++) {
-                        while (!spin1_send_mc_packet(spike_key, 0,
-                                                     NO_PAYLOAD)) {
-                            spin1_delay_us(1);
-                        }
+        uint32_t delay_stage_delay = (d + 1) * DELAY_STAGE_LENGTH;
+        uint32_t delay_stage_time_slot =
+            ((time - delay_stage_delay) & num_delay_slots_mask);
+        uint8_t *delay_stage_spike_counters =
+            spike_counters[delay_stage_time_slot];
+        bit_field_t delay_stage_active =
+            spike_slot_active[delay_stage_time_slot];
+
+        log_debug("Checking time slot %u for delay stage %u",
+                  delay_stage_time_slot, d);
+
+        // Loop through the neurons which spiked in this slot and emit
+        // spikes after this stage, lowest first
+        for (uint32_t w = 0; w < neuron_bit_field_words; w++) {
+            uint32_t bits = delay_stage_active[w] & delay_stage_config[w];
+            while (bits != 0) {
+                uint32_t n = (w << 5) + __builtin_ctz(bits);
+                bits &= bits - 1;
+
+                // Calculate key all spikes coming from this neuron will be
+                // sent with
+                uint32_t spike_key = ((d * num_neurons) + n) + key;
+
+                log_debug("Neuron %u sending %u spikes after delay"
+                          "stage %u with key %x",
+                          n, delay_stage_spike_counters[n], d, spike_key);
+
+                // Loop through counted spikes and send
+                for (uint32_t s = 0; s < delay_stage_spike_counters[n];
+                        s++) {
+                    while (!spin1_send_mc_packet(spike_key, 0, NO_PAYLOAD)) {
+                        spin1_delay_us(1);
                     }
                 }
             }
         }
     }
 
-    // Zero all counters in current time slot
+    // Zero the counters of the neurons which spiked in the current time slot
+    // when it was last used, so that it can count the spikes of this step
     uint32_t current_time_slot = time & num_delay_slots_mask;
     uint8_t *current_time_slot_spike_counters =
         spike_counters[current_time_slot];
-    memset(current_time_slot_spike_counters, 0, sizeof(uint8_t) * num_neurons);
+    bit_field_t current_time_slot_active = spike_slot_active[current_time_slot];
+    for (uint32_t w = 0; w < neuron_bit_field_words; w++) {
+        uint32_t bits = current_time_slot_active[w];
+        while (bits != 0) {
+            current_time_slot_spike_counters[(w << 5) + __builtin_ctz(bits)] =
+                0;
+            bits &= bits - 1;
+        }
+        current_time_slot_active[w] = 0;
+    }
+}
+
+//! \brief Writes the counts of lost and discarded spikes to the provenance
+//!        data region
+//! \param[in] provenance_region The start of the extra provenance data
+void store_provenance_data(address_t provenance_region) {
+    log_debug("writing other provenance data");
+
+    provenance_region[N_BUFFER_OVERFLOWS] = n_buffer_overflows;
+    provenance_region[N_COUNTER_SATURATIONS] = n_counter_saturations;
+    provenance_region[N_INVALID_KEYS] = n_invalid_keys;
+    profiler_store_provenance(&provenance_region[PROFILER_DATA_START]);
+
+    log_debug("finished other provenance data");
+}
+
+void timer_callback(uint unused0, uint unused1) {
+    use(unused0);
+    use(unused1);
+
+    for (uint32_t step = 0; step < timesteps_per_tick; step++) {
+        time++;
+
+        log_debug("Timer tick %u", time);
+
+        // If a fixed number of simulation ticks are specified and these have
+        // passed
+        if (infinite_run != TRUE && time >= simulation_ticks) {
+
+            // handle the pause and resume functionality
+            simulation_handle_pause_resume(NULL);
+
+            // Subtract 1 from the time so this tick gets done again on the
+            // next run
+            time -= 1;
+            return;
+        }
+
+        profiler_start(PROFILER_TIMER);
+        _do_timestep_update();
+        profiler_end(PROFILER_TIMER);
+    }
 }
 
 // Entry point
@@ -299,11 +383,13 @@ void c_main(void) {
         rt_error(RTE_SWERR);
     }
 
+    profiler_initialise(timer_period);
+
     // Start the time at "-1" so that the first tick will be 0
     time = UINT32_MAX;
 
     // Initialise the incoming spike buffer
-    if (!in_spikes_initialize_spike_buffer(256)) {
+    if (!in_spikes_initialize_spike_buffer(incoming_spike_buffer_size)) {
          rt_error(RTE_SWERR);
     }
 
@@ -319,7 +405,8 @@ void c_main(void) {
         &simulation_ticks, &infinite_run, SDP);
 
     // set up provenance registration
-    simulation_register_provenance_callback(NULL, PROVENANCE_REGION);
+    simulation_register_provenance_callback(
+        store_provenance_data, PROVENANCE_REGION);
 
     simulation_run();
 }
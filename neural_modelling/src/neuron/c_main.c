@@ -15,6 +15,7 @@
  */
 
 #include "../common/in_spikes.h"
+#include "../common/profiler.h"
 #include "neuron.h"
 #include "synapses.h"
 #include "spike_processing.h"
@@ -23,6 +24,7 @@
 
 #include <data_specification.h>
 #include <simulation.h>
+#include <spin1_api.h>
 #include <debug.h>
 
 /* validates that the model being compiled does indeed contain a application
@@ -44,7 +46,8 @@ typedef enum regions_e{
     BUFFERING_OUT_POTENTIAL_RECORDING_REGION,
     BUFFERING_OUT_GSYN_RECORDING_REGION,
     BUFFERING_OUT_CONTROL_REGION,
-    PROVENANCE_DATA_REGION
+    PROVENANCE_DATA_REGION,
+    PLASTIC_WEIGHTS_REGION
 } regions_e;
 
 typedef enum extra_provenance_data_region_entries{
@@ -52,6 +55,11 @@ typedef enum extra_provenance_data_region_entries{
     SYNAPTIC_WEIGHT_SATURATION_COUNT = 1,
     INPUT_BUFFER_OVERFLOW_COUNT = 2,
     CURRENT_TIMER_TICK = 3,
+    TIMER_TICK_OVERRUN_COUNT = 4,
+    LATE_SPIKE_COUNT = 5,
+    MAX_SPIKE_LATENESS = 6,
+    TRUNCATED_POST_WINDOW_COUNT = 7,
+    PROFILER_DATA_START = 8,
 } extra_provenance_data_region_entries;
 
 //! values for the priority for each callback
@@ -77,6 +85,13 @@ static uint32_t infinite_run;
 //! The recording flags
 static uint32_t recording_flags = 0;
 
+//! The number of simulation time steps to run each timer tick
+static uint32_t timesteps_per_tick = 1;
+
+//! The number of timer ticks whose time steps did not complete before the
+//! next timer tick
+static uint32_t n_timer_tick_overruns = 0;
+
 //! \brief Initialises the recording parts of the model
 //! \return True if recording initialisation is successful, false otherwise
 static bool initialise_recording(){
@@ -135,7 +150,8 @@ static bool initialise(uint32_t *timer_period) {
     uint32_t incoming_spike_buffer_size;
     if (!neuron_initialise(
             data_specification_get_region(NEURON_PARAMS_REGION, address),
-            recording_flags, &n_neurons, &incoming_spike_buffer_size)) {
+            recording_flags, &n_neurons, &incoming_spike_buffer_size,
+            &timesteps_per_tick)) {
         return false;
     }
 
@@ -149,6 +165,9 @@ static bool initialise(uint32_t *timer_period) {
         return false;
     }
     neuron_set_input_buffers(input_buffers);
+    synapses_initialise_plastic_weights(
+        data_specification_get_region(PLASTIC_WEIGHTS_REGION, address),
+        data_specification_get_region(SYNAPTIC_MATRIX_REGION, address));
 
     // Set up the population table
     uint32_t row_max_n_words;
@@ -171,6 +190,9 @@ static bool initialise(uint32_t *timer_period) {
             incoming_spike_buffer_size)) {
         return false;
     }
+
+    profiler_initialise(*timer_period);
+
     log_info("Initialise: finished");
     return true;
 }
@@ -186,6 +208,14 @@ void c_main_store_provenance_data(address_t provenance_region){
     provenance_region[INPUT_BUFFER_OVERFLOW_COUNT] =
         spike_processing_get_buffer_overflows();
     provenance_region[CURRENT_TIMER_TICK] = time;
+    provenance_region[TIMER_TICK_OVERRUN_COUNT] = n_timer_tick_overruns;
+    provenance_region[LATE_SPIKE_COUNT] =
+        spike_processing_get_n_late_spikes();
+    provenance_region[MAX_SPIKE_LATENESS] =
+        spike_processing_get_max_lateness_us();
+    provenance_region[TRUNCATED_POST_WINDOW_COUNT] =
+        synapse_dynamics_get_n_truncated_post_windows();
+    profiler_store_provenance(&provenance_region[PROFILER_DATA_START]);
     log_debug("finished other provenance data");
 }
 
@@ -195,47 +225,85 @@ void resume_callback() {
         log_error("Error setting up recording");
         rt_error(RTE_SWERR);
     }
+
+    // Pick up any change to plasticity made between runs
+    synapse_dynamics_resume();
+
+    // The plastic weights written at the end of the last run will change
+    synapses_invalidate_plastic_weights();
 }
 
-//! \brief Timer interrupt callback
+//! \brief Timer interrupt callback; runs timesteps_per_tick time steps
 //! \param[in] timer_count the number of times this call back has been
 //!            executed since start of simulation
 //! \param[in] unused unused parameter kept for API consistency
 //! \return None
 void timer_callback(uint timer_count, uint unused) {
-    use(timer_count);
     use(unused);
 
-    time++;
+    profiler_start(PROFILER_TIMER);
 
-    log_debug("Timer tick %u \n", time);
+    // Note any spikes from the previous tick that are yet to be processed
+    spike_processing_timer_tick();
 
-    /* if a fixed number of simulation ticks that were specified at startup
-       then do reporting for finishing */
-    if (infinite_run != TRUE && time >= simulation_ticks) {
+    for (uint32_t step = 0; step < timesteps_per_tick; step++) {
+        time++;
 
-        // Enter pause and resume state to avoid another tick
-        simulation_handle_pause_resume(resume_callback);
+        log_debug("Timer tick %u \n", time);
 
-        // Finalise any recordings that are in progress, writing back the final
-        // amounts of samples recorded to SDRAM
-        if (recording_flags > 0) {
-            log_info("updating recording regions");
-            recording_finalise();
+        /* if a fixed number of simulation ticks that were specified at startup
+           then do reporting for finishing */
+        if (infinite_run != TRUE && time >= simulation_ticks) {
+
+            // Write out the plastic weights for the host to read, before
+            // the host is told that the run has finished; the rows are read
+            // directly, so any still being processed or written back must
+            // be finished first
+            if (synapses_has_plastic_weights()) {
+                spike_processing_wait_for_idle();
+                synapses_write_plastic_weights();
+            }
+
+            // Enter pause and resume state to avoid another tick
+            simulation_handle_pause_resume(resume_callback);
+
+            // Finalise any recordings that are in progress, writing back the
+            // final amounts of samples recorded to SDRAM
+            if (recording_flags > 0) {
+                log_info("updating recording regions");
+                recording_finalise();
+            }
+
+            // Subtract 1 from the time so this tick gets done again on the
+            // next run
+            time -= 1;
+            profiler_end(PROFILER_TIMER);
+            return;
         }
+        // otherwise do synapse and neuron time step updates
+        profiler_start(PROFILER_SYNAPSE_TRANSFER);
+        synapses_do_timestep_update(time);
+        profiler_end(PROFILER_SYNAPSE_TRANSFER);
+
+        profiler_start(PROFILER_NEURON_UPDATE);
+        neuron_do_timestep_update(time);
+        profiler_end(PROFILER_NEURON_UPDATE);
 
-        // Subtract 1 from the time so this tick gets done again on the next
-        // run
-        time -= 1;
-        return;
+        // trigger buffering_out_mechanism
+        if (recording_flags > 0) {
+            profiler_start(PROFILER_RECORDING);
+            recording_do_timestep_update(time);
+            profiler_end(PROFILER_RECORDING);
+        }
     }
-    // otherwise do synapse and neuron time step updates
-    synapses_do_timestep_update(time);
-    neuron_do_timestep_update(time);
 
-    // trigger buffering_out_mechanism
-    if (recording_flags > 0) {
-        recording_do_timestep_update(time);
+    profiler_end(PROFILER_TIMER);
+
+    // If a later timer interrupt has happened since this callback was
+    // scheduled, the time steps did not fit in the timer period; the API
+    // counts the interrupts, and passed the count at the time of this one
+    if (spin1_get_simulation_time() != timer_count) {
+        n_timer_tick_overruns++;
     }
 }
 
@@ -254,8 +322,9 @@ void c_main(void) {
     time = UINT32_MAX;
 
     // Set timer tick (in microseconds)
-    log_info("setting timer tick callback for %d microseconds",
-              timer_period);
+    log_info("setting timer tick callback for %d microseconds,"
+             " running %u time steps per tick",
+             timer_period, timesteps_per_tick);
     spin1_set_timer_tick(timer_period);
 
     // Set up the timer tick callback (others are handled elsewhere)
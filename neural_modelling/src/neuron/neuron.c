@@ -20,6 +20,10 @@
 #define V_RECORDING_CHANNEL 1
 #define GSYN_RECORDING_CHANNEL 2
 
+//! The value of the voltage compression shift which indicates that voltages
+//! are recorded in full
+#define NO_V_COMPRESSION 0xFFFFFFFF
+
 //! Array of neuron states
 static neuron_pointer_t neuron_array;
 
@@ -55,6 +59,14 @@ static input_t *input_buffers;
 static timed_state_t *voltages;
 uint32_t voltages_size;
 
+//! storage for compressed neuron state with timestamp, if requested
+static timed_compressed_state_t *compressed_voltages;
+static uint32_t compressed_voltages_size;
+
+//! The right shift applied to each voltage difference when compressing, or
+//! NO_V_COMPRESSION if voltages are recorded in full
+static uint32_t v_compression_shift;
+
 //! storage for neuron input with timestamp
 static timed_input_t *inputs;
 uint32_t input_size;
@@ -63,7 +75,8 @@ uint32_t input_size;
 //! readable form
 typedef enum parmeters_in_neuron_parameter_data_region {
     HAS_KEY, TRANSMISSION_KEY, N_NEURONS_TO_SIMULATE,
-    INCOMING_SPIKE_BUFFER_SIZE, START_OF_GLOBAL_PARAMETERS,
+    INCOMING_SPIKE_BUFFER_SIZE, V_COMPRESSION_SHIFT, TIMESTEPS_PER_TICK,
+    START_OF_GLOBAL_PARAMETERS,
 } parmeters_in_neuron_parameter_data_region;
 
 
@@ -97,15 +110,45 @@ static inline void _print_neuron_parameters() {
 #endif // LOG_LEVEL >= LOG_DEBUG
 }
 
+//! \brief private method for recording the voltages of the time step as
+//!        differences from the lowest voltage, each shifted right by
+//!        v_compression_shift and clipped to 16 bits
+//! \param[in] time the timer tick value currently being executed
+static inline void _record_compressed_voltages(uint32_t time) {
+    state_t baseline = voltages->states[0];
+    for (index_t n = 1; n < n_neurons; n++) {
+        if (REAL_COMPARE(voltages->states[n], <, baseline)) {
+            baseline = voltages->states[n];
+        }
+    }
+
+    for (index_t n = 0; n < n_neurons; n++) {
+        uint32_t delta = ((uint32_t) (
+            bitsk(voltages->states[n]) - bitsk(baseline))) >>
+            v_compression_shift;
+        compressed_voltages->deltas[n] = (delta > 0xFFFF)? 0xFFFF: delta;
+    }
+
+    compressed_voltages->time = time;
+    compressed_voltages->baseline = baseline;
+    recording_record(
+        V_RECORDING_CHANNEL, compressed_voltages, compressed_voltages_size);
+}
+
 //! \brief Set up the neuron models
 //! \param[in] address the absolute address in SDRAM for the start of the
 //!            NEURON_PARAMS data region in SDRAM
 //! \param[in] recording_flags_param the recordings parameters
 //!            (contains which regions are active and how big they are)
 //! \param[out] n_neurons_value The number of neurons this model is to emulate
+//! \param[out] incoming_spike_buffer_size The number of spikes to support in
+//!             the incoming spike buffer
+//! \param[out] timesteps_per_tick The number of time steps to run on each
+//!             timer tick
 //! \return True is the initialisation was successful, otherwise False
 bool neuron_initialise(address_t address, uint32_t recording_flags_param,
-        uint32_t *n_neurons_value, uint32_t *incoming_spike_buffer_size) {
+        uint32_t *n_neurons_value, uint32_t *incoming_spike_buffer_size,
+        uint32_t *timesteps_per_tick) {
     log_info("neuron_initialise: starting");
 
     // Check if there is a key to use
@@ -129,6 +172,12 @@ bool neuron_initialise(address_t address, uint32_t recording_flags_param,
     // Read the size of the incoming spike buffer to use
     *incoming_spike_buffer_size = address[INCOMING_SPIKE_BUFFER_SIZE];
 
+    // Read how the voltages are to be recorded
+    v_compression_shift = address[V_COMPRESSION_SHIFT];
+
+    // Read the number of time steps to run on each timer tick
+    *timesteps_per_tick = address[TIMESTEPS_PER_TICK];
+
     uint32_t next = START_OF_GLOBAL_PARAMETERS;
 
     // Read the global parameter details
@@ -213,6 +262,23 @@ bool neuron_initialise(address_t address, uint32_t recording_flags_param,
 
     voltages_size = sizeof(uint32_t) + sizeof(state_t) * n_neurons;
     voltages = (timed_state_t *) spin1_malloc(voltages_size);
+    if (v_compression_shift != NO_V_COMPRESSION) {
+        log_info("\tRecording voltages compressed with shift %u",
+                 v_compression_shift);
+
+        // The deltas are padded to a whole number of words
+        compressed_voltages_size = sizeof(timed_compressed_state_t) +
+            (((n_neurons + 1) >> 1) * sizeof(uint32_t));
+        compressed_voltages = (timed_compressed_state_t *) spin1_malloc(
+            compressed_voltages_size);
+        if (compressed_voltages == NULL) {
+            log_error("Unable to allocate compressed voltages - Out of DTCM");
+            return false;
+        }
+        if (n_neurons & 0x1) {
+            compressed_voltages->deltas[n_neurons] = 0;
+        }
+    }
     input_size = sizeof(uint32_t) + sizeof(input_struct_t) * n_neurons;
     inputs = (timed_input_t *) spin1_malloc(input_size);
 
@@ -307,8 +373,12 @@ void neuron_do_timestep_update(timer_t time) {
 
     // record neuron state (membrane potential) if needed
     if (recording_is_channel_enabled(recording_flags, V_RECORDING_CHANNEL)) {
-        voltages->time = time;
-        recording_record(V_RECORDING_CHANNEL, voltages, voltages_size);
+        if (v_compression_shift != NO_V_COMPRESSION) {
+            _record_compressed_voltages(time);
+        } else {
+            voltages->time = time;
+            recording_record(V_RECORDING_CHANNEL, voltages, voltages_size);
+        }
     }
 
     // record neuron inputs if needed
@@ -28,11 +28,13 @@
 //! \param[out] n_neurons_value The number of neurons this model is to emulate
 //! \param[out] incoming_spike_buffer_size The number of spikes to support in
 //!             the incoming spike buffer
+//! \param[out] timesteps_per_tick The number of time steps to run on each
+//!             timer tick
 //! \return boolean which is True is the translation was successful
 //!         otherwise False
 bool neuron_initialise(
     address_t address, uint32_t recording_flags, uint32_t *n_neurons_value,
-    uint32_t *incoming_spike_buffer_size);
+    uint32_t *incoming_spike_buffer_size, uint32_t *timesteps_per_tick);
 
 //! \setter for the internal input buffers
 //! \param[in] input_buffers_value the new input buffers
@@ -3,6 +3,8 @@
 
 // Standard includes
 #include "../../../common/neuron-typedefs.h"
+#include <spin1_api.h>
+#include <debug.h>
 
 //---------------------------------------
 // Macros
@@ -10,6 +12,28 @@
 #define MIN(X,Y) ((X) < (Y) ? (X) : (Y))
 #define MAX(X,Y) ((X) > (Y) ? (X) : (Y))
 
+// The fields of the word describing each exponential decay lookup table
+#define EXP_LUT_SIZE_MASK 0xFFFF
+#define EXP_LUT_TIME_SHIFT_SHIFT 16
+#define EXP_LUT_TIME_SHIFT_MASK 0x1F
+#define EXP_LUT_INTERPOLATE_BIT 21
+#define EXP_LUT_SHARED_SHIFT 24
+
+//---------------------------------------
+// Structures
+//---------------------------------------
+// An exponential decay lookup table, sampled every 2^time_shift time steps
+typedef struct exp_lut_t {
+    uint32_t size;
+    uint32_t time_shift;
+
+    // True if values between entries are linearly interpolated
+    bool interpolate;
+
+    // The entries, which may be shared with another table
+    int16_t *entries;
+} exp_lut_t;
+
 //---------------------------------------
 // Plasticity maths function inline implementation
 //---------------------------------------
@@ -27,6 +51,40 @@ static inline address_t maths_copy_int16_lut(
     return start_address + num_words;
 }
 
+//---------------------------------------
+// Reads a sequence of exponential decay lookup tables, each of which is a word
+// describing the table followed by its entries; a table identical to an
+// earlier one instead gives the index of that table (plus one) and no entries
+static inline address_t maths_read_exp_luts(
+        address_t start_address, uint32_t n_luts, exp_lut_t **luts) {
+    address_t address = start_address;
+    for (uint32_t i = 0; i < n_luts; i++) {
+        exp_lut_t *lut = luts[i];
+        uint32_t description = *address++;
+        lut->size = description & EXP_LUT_SIZE_MASK;
+        lut->time_shift = (description >> EXP_LUT_TIME_SHIFT_SHIFT)
+                          & EXP_LUT_TIME_SHIFT_MASK;
+        lut->interpolate = (description >> EXP_LUT_INTERPOLATE_BIT) & 0x1;
+
+        uint32_t shared = description >> EXP_LUT_SHARED_SHIFT;
+        if (shared != 0) {
+            lut->entries = luts[shared - 1]->entries;
+        } else {
+            lut->entries = (int16_t *) spin1_malloc(
+                lut->size * sizeof(int16_t));
+            if (lut->entries == NULL) {
+                log_error("Unable to allocate exponential lookup table");
+                return NULL;
+            }
+            address = maths_copy_int16_lut(address, lut->size, lut->entries);
+        }
+        log_info("\tLookup table %u: %u entries, time shift %u,"
+                 " interpolate %u, shared with %d", i, lut->size,
+                 lut->time_shift, lut->interpolate, ((int32_t) shared) - 1);
+    }
+    return address;
+}
+
 static inline int32_t maths_clamp_pot(int32_t x, uint32_t shift) {
     uint32_t y = x >> shift;
     if (y) {
@@ -44,14 +102,25 @@ static inline int32_t maths_mul_16x16(int16_t x, int16_t y) {
 
 //---------------------------------------
 static inline int32_t maths_lut_exponential_decay(
-        uint32_t time, const uint32_t time_shift, const uint32_t lut_size,
-        const int16_t *lut) {
+        uint32_t time, const exp_lut_t *lut) {
 
     // Calculate lut index
+    const uint32_t time_shift = lut->time_shift;
     uint32_t lut_index = time >> time_shift;
+    if (lut_index >= lut->size) {
+        return 0;
+    }
 
-    // Return value from LUT
-    return (lut_index < lut_size) ? lut[lut_index] : 0;
+    // Get value from LUT, interpolating towards the next entry (or towards
+    // zero after the last) if the table is sampled less than every time step
+    int32_t value = lut->entries[lut_index];
+    if (lut->interpolate) {
+        int32_t next = ((lut_index + 1) < lut->size) ?
+            lut->entries[lut_index + 1] : 0;
+        int32_t fraction = time & ((1 << time_shift) - 1);
+        value += ((next - value) * fraction) >> time_shift;
+    }
+    return value;
 }
 
 //---------------------------------------
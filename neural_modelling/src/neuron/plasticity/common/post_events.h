@@ -11,37 +11,119 @@
 //---------------------------------------
 // Macros
 //---------------------------------------
-#define MAX_POST_SYNAPTIC_EVENTS 16
+// If POST_EVENT_TIMES_COMPRESSED is defined, event times are stored as 16-bit
+// offsets from a base time per neuron, halving the size of the times in the
+// history.  Events more than POST_EVENT_MAX_TIME_OFFSET time steps older than
+// the newest are dropped when the base time moves on.
+#ifdef POST_EVENT_TIMES_COMPRESSED
+#define POST_EVENT_MAX_TIME_OFFSET 0xFFFF
+typedef uint16_t post_event_time_t;
+#else
+typedef uint32_t post_event_time_t;
+#endif
 
 //---------------------------------------
 // Structures
 //---------------------------------------
+// Circular history of post-synaptic events. The entry at head is always
+// the placeholder at time 0; the events follow it in time order.
 typedef struct {
     uint32_t count_minus_one;
+    uint32_t head;
 
-    uint32_t times[MAX_POST_SYNAPTIC_EVENTS];
-    post_trace_t traces[MAX_POST_SYNAPTIC_EVENTS];
+    // The time of the newest event dropped to make space in the history
+    uint32_t dropped_time;
+
+#ifdef POST_EVENT_TIMES_COMPRESSED
+    // The time which the stored times are relative to
+    uint32_t base_time;
+#endif
+
+    post_event_time_t *times;
+    post_trace_t *traces;
 } post_event_history_t;
 
 typedef struct {
     post_trace_t prev_trace;
     uint32_t prev_time;
-    const post_trace_t *next_trace;
-    const uint32_t *next_time;
+    post_trace_t next_trace;
+    uint32_t next_time;
+    const post_event_history_t *events;
+    uint32_t next_index;
     uint32_t num_events;
 } post_event_window_t;
 
+//---------------------------------------
+// Globals
+//---------------------------------------
+// The number of entries in each history, set by the host; this is a power of
+// two so that the history can be indexed with a mask
+static uint32_t _post_events_max_events;
+static uint32_t _post_events_index_mask;
+
+// The number of windows which should have included events which had already
+// been dropped from the history
+static uint32_t _post_events_n_truncated_windows = 0;
+
 //---------------------------------------
 // Inline functions
+//---------------------------------------
+static inline uint32_t _post_events_index(
+        const post_event_history_t *events, uint32_t position) {
+    return (events->head + position) & _post_events_index_mask;
+}
+
+//---------------------------------------
+// Gets the time of the event at the given index, which must not be the
+// placeholder at the head
+static inline uint32_t _post_events_event_time(
+        const post_event_history_t *events, uint32_t index) {
+#ifdef POST_EVENT_TIMES_COMPRESSED
+    return events->base_time + events->times[index];
+#else
+    return events->times[index];
+#endif
+}
+
+//---------------------------------------
+// Gets the time of the event at the given position, including the
+// placeholder
+static inline uint32_t _post_events_time(
+        const post_event_history_t *events, uint32_t position) {
+#ifdef POST_EVENT_TIMES_COMPRESSED
+    if (position == 0) {
+        return 0;
+    }
+#endif
+    return _post_events_event_time(
+        events, _post_events_index(events, position));
+}
+
 //---------------------------------------
 static inline post_event_history_t *post_events_init_buffers(
-        uint32_t n_neurons) {
+        uint32_t n_neurons, uint32_t max_events) {
+
+    // Check the history can be indexed with a mask
+    if (max_events < 2 || (max_events & (max_events - 1)) != 0) {
+        log_error("Post-synaptic event history size %u is not a power of two",
+                  max_events);
+        return NULL;
+    }
+    _post_events_max_events = max_events;
+    _post_events_index_mask = max_events - 1;
+    log_info("Post-synaptic event history size %u", max_events);
+
     post_event_history_t *post_event_history =
         (post_event_history_t*) spin1_malloc(
             n_neurons * sizeof(post_event_history_t));
+    post_event_time_t *times = (post_event_time_t*) spin1_malloc(
+        n_neurons * max_events * sizeof(post_event_time_t));
+    post_trace_t *traces = (post_trace_t*) spin1_malloc(
+        n_neurons * max_events * sizeof(post_trace_t));
 
     // Check allocations succeeded
-    if (post_event_history == NULL) {
+    if (post_event_history == NULL || times == NULL
+            || (traces == NULL && sizeof(post_trace_t) > 0)) {
         log_error(
             "Unable to allocate global STDP structures - Out of DTCM: Try "
             "reducing the number of neurons per core to fix this problem ");
@@ -51,144 +133,262 @@ static inline post_event_history_t *post_events_init_buffers(
     // Loop through neurons
     for (uint32_t n = 0; n < n_neurons; n++) {
 
+        post_event_history[n].times = &times[n * max_events];
+        post_event_history[n].traces = &traces[n * max_events];
+
         // Add initial placeholder entry to buffer
         post_event_history[n].times[0] = 0;
         post_event_history[n].traces[0] = timing_get_initial_post_trace();
         post_event_history[n].count_minus_one = 0;
+        post_event_history[n].head = 0;
+        post_event_history[n].dropped_time = 0;
+#ifdef POST_EVENT_TIMES_COMPRESSED
+        post_event_history[n].base_time = 0;
+#endif
     }
 
     return post_event_history;
 }
 
-static inline post_event_window_t post_events_get_window(
-        const post_event_history_t *events, uint32_t begin_time) {
+//---------------------------------------
+static inline uint32_t post_events_get_last_time(
+        const post_event_history_t *events) {
+    return _post_events_time(events, events->count_minus_one);
+}
 
-    // Start at end event - beyond end of post-event history
-    const uint32_t count = events->count_minus_one + 1;
-    const uint32_t *end_event_time = events->times + count;
-    const post_trace_t *end_event_trace = events->traces + count;
-    const uint32_t *event_time = end_event_time;
-    post_event_window_t window;
-    do {
+//---------------------------------------
+static inline post_trace_t post_events_get_last_trace(
+        const post_event_history_t *events) {
+    return events->traces[_post_events_index(events, events->count_minus_one)];
+}
+
+//---------------------------------------
+// Fills in the previous event from the given position in the history and
+// the next event from the one following it
+// **NOTE** the masked index is always in range, so the next event can be
+// read even when there are no events left - it just won't be valid
+static inline post_event_window_t _post_events_make_window(
+        const post_event_history_t *events, uint32_t begin_time,
+        uint32_t prev_position, uint32_t num_events) {
 
-        // Cache pointer to this event as potential
-        // Next event and go back one event
-        // **NOTE** next_time can be invalid
-        window.next_time = event_time--;
+    // If the window reaches back to the placeholder, but events that it
+    // should have included have been dropped, the update will be wrong
+    if (prev_position == 0 && begin_time < events->dropped_time) {
+        _post_events_n_truncated_windows++;
     }
 
-    // Keep looping while event occurred after start
-    // Of window and we haven't hit beginning of array
-    while (*event_time > begin_time && event_time != events->times);
+    post_event_window_t window;
+    const uint32_t prev_index = _post_events_index(events, prev_position);
+    window.events = events;
+    window.prev_time = _post_events_time(events, prev_position);
+    window.prev_trace = events->traces[prev_index];
+    window.next_index = (prev_index + 1) & _post_events_index_mask;
+    window.num_events = num_events;
+    window.next_time = _post_events_event_time(events, window.next_index);
+    window.next_trace = events->traces[window.next_index];
+    return window;
+}
 
-    // Deference event to use as previous
-    window.prev_time = *event_time;
+//---------------------------------------
+static inline post_event_window_t post_events_get_window(
+        const post_event_history_t *events, uint32_t begin_time) {
 
-    // Calculate number of events
-    window.num_events = (end_event_time - window.next_time);
+    // Walk back from the last event until one occurred at or before the
+    // start of the window, or we hit the placeholder at the head
+    const uint32_t count = events->count_minus_one + 1;
+    uint32_t position = events->count_minus_one;
+    while (position > 0
+            && _post_events_event_time(
+                events, _post_events_index(events, position)) > begin_time) {
+        position--;
+    }
 
-    // Using num_events, find next and previous traces
-    window.next_trace = (end_event_trace - window.num_events);
-    window.prev_trace = *(window.next_trace - 1);
+    // All the events after this one are in the window
+    return _post_events_make_window(
+        events, begin_time, position, count - position - 1);
+}
 
-    // Return window
-    return window;
+//---------------------------------------
+// Finds the position of the event before the start of a delayed window and
+// the position just after the last event in the window
+static inline void _post_events_find_window_delayed(
+        const post_event_history_t *events, uint32_t begin_time,
+        uint32_t end_time, uint32_t *prev_position, uint32_t *end_position) {
+
+    // Walk back from the last event until one occurred at or before the
+    // start of the window, or we hit the placeholder at the head
+    uint32_t end = events->count_minus_one + 1;
+    uint32_t position = events->count_minus_one;
+    while (true) {
+        const uint32_t event_time = _post_events_time(events, position);
+
+        // If this event is still in the future, move the end back over it
+        if (event_time > end_time) {
+            end = position;
+        }
+        if (position == 0 || event_time <= begin_time) {
+            break;
+        }
+        position--;
+    }
+
+    *prev_position = position;
+    *end_position = end;
 }
 
 //---------------------------------------
 static inline post_event_window_t post_events_get_window_delayed(
         const post_event_history_t *events, uint32_t begin_time,
         uint32_t end_time) {
+    uint32_t position;
+    uint32_t end_position;
+    _post_events_find_window_delayed(
+        events, begin_time, end_time, &position, &end_position);
 
-    // Start at end event - beyond end of post-event history
-    const uint32_t count = events->count_minus_one + 1;
-    const uint32_t *end_event_time = events->times + count;
-    const uint32_t *event_time = end_event_time;
+    return _post_events_make_window(
+        events, begin_time, position, end_position - position - 1);
+}
 
-    post_event_window_t window;
-    do {
-        // Cache pointer to this event as potential
-        // Next event and go back one event
-        // **NOTE** next_time can be invalid
-        window.next_time = event_time--;
-
-        // If this event is still in the future, move the end time back
-        if (*event_time > end_time) {
-            end_event_time = window.next_time;
-        }
+//---------------------------------------
+// As post_events_get_window_delayed, but first tries the position where the
+// last window requested from this history started.  Synapses updated in the
+// same time step mostly ask for the same window of a neuron, so this usually
+// avoids walking back through the history.  The cached position is checked
+// against the events around it, so it stays safe to use after the neuron
+// spikes.
+static inline post_event_window_t post_events_get_window_delayed_cached(
+        const post_event_history_t *events, uint32_t begin_time,
+        uint32_t end_time, uint8_t *cached_position) {
+    const uint32_t last_position = events->count_minus_one;
+    uint32_t position = *cached_position;
+
+    // The cached position can be used if it is the last event at or before
+    // the start of the window, and no events are after the end of the window
+    if (position <= last_position
+            && _post_events_time(events, last_position) <= end_time
+            && _post_events_time(events, position) <= begin_time
+            && (position == last_position
+                || _post_events_time(events, position + 1) > begin_time)) {
+        return _post_events_make_window(
+            events, begin_time, position, last_position - position);
     }
 
-    // Keep looping while event occurred after start
-    // Of window and we haven't hit beginning of array
-    while (*event_time > begin_time && event_time != events->times);
-
-    // Deference event to use as previous
-    window.prev_time = *event_time;
+    // Otherwise walk the history and cache the result
+    uint32_t end_position;
+    _post_events_find_window_delayed(
+        events, begin_time, end_time, &position, &end_position);
+    *cached_position = (uint8_t) position;
 
-    // Calculate number of events
-    window.num_events = (end_event_time - window.next_time);
+    return _post_events_make_window(
+        events, begin_time, position, end_position - position - 1);
+}
 
-    // Using num_events, find next and previous traces
-    const post_trace_t *end_event_trace = events->traces + count;
-    window.next_trace = (end_event_trace - window.num_events);
-    window.prev_trace = *(window.next_trace - 1);
+//---------------------------------------
+static inline post_event_window_t _post_events_advance(
+        post_event_window_t window) {
 
-    // Return window
+    // Decrement remaining events and move onto the next one
+    window.num_events--;
+    window.next_index = (window.next_index + 1) & _post_events_index_mask;
+    window.next_time = _post_events_event_time(
+        window.events, window.next_index);
+    window.next_trace = window.events->traces[window.next_index];
     return window;
 }
 
 //---------------------------------------
 static inline post_event_window_t post_events_next(post_event_window_t window) {
 
-    // Update previous time and increment next time
-    window.prev_time = *window.next_time++;
-    window.prev_trace = *window.next_trace++;
+    // Update previous time and trace
+    window.prev_time = window.next_time;
+    window.prev_trace = window.next_trace;
 
-    // Decrement remaining events
-    window.num_events--;
-    return window;
+    // Go onto next event
+    return _post_events_advance(window);
 }
 
 //---------------------------------------
 static inline post_event_window_t post_events_next_delayed(
         post_event_window_t window, uint32_t delayed_time) {
 
-    // Update previous time and increment next time
+    // Update previous time and trace
     window.prev_time = delayed_time;
-    window.prev_trace = *window.next_trace++;
+    window.prev_trace = window.next_trace;
 
     // Go onto next event
-    window.next_time++;
+    return _post_events_advance(window);
+}
 
-    // Decrement remaining events
-    window.num_events--;
-    return window;
+//---------------------------------------
+// Drops the oldest event by moving the time 0 placeholder forward over it
+static inline void _post_events_drop_oldest(post_event_history_t *events) {
+    const uint32_t old_head = events->head;
+    events->head = (old_head + 1) & _post_events_index_mask;
+    events->dropped_time = _post_events_event_time(events, events->head);
+    events->times[events->head] = events->times[old_head];
+    events->traces[events->head] = events->traces[old_head];
 }
 
+#ifdef POST_EVENT_TIMES_COMPRESSED
+//---------------------------------------
+// Moves the base time on so that the given time can be stored, dropping any
+// events which are then too old to be stored
+static inline void _post_events_rebase(
+        post_event_history_t *events, uint32_t time) {
+    while (events->count_minus_one > 0
+            && (time - _post_events_time(events, 1))
+                > POST_EVENT_MAX_TIME_OFFSET) {
+        _post_events_drop_oldest(events);
+        events->count_minus_one--;
+    }
+
+    // Rebase on the oldest remaining event, or the new one if there are none
+    const uint32_t base_time = (events->count_minus_one > 0) ?
+        _post_events_time(events, 1) : time;
+    const uint32_t shift = base_time - events->base_time;
+    for (uint32_t p = 1; p <= events->count_minus_one; p++) {
+        events->times[_post_events_index(events, p)] -= shift;
+    }
+    events->base_time = base_time;
+}
+#endif
+
 //---------------------------------------
 static inline void post_events_add(uint32_t time, post_event_history_t *events,
                                    post_trace_t trace) {
 
-    if (events->count_minus_one < (MAX_POST_SYNAPTIC_EVENTS - 1)) {
+#ifdef POST_EVENT_TIMES_COMPRESSED
+    // If the time is too far past the base time to be stored, rebase
+    if ((time - events->base_time) > POST_EVENT_MAX_TIME_OFFSET) {
+        _post_events_rebase(events, time);
+    }
+#endif
 
-        // If there's still space, store time at current end
-        // and increment count minus 1
-        const uint32_t new_index = ++events->count_minus_one;
-        events->times[new_index] = time;
-        events->traces[new_index] = trace;
-    } else {
+    if (events->count_minus_one < (_post_events_max_events - 1)) {
 
-        // Otherwise Shuffle down elements
-        // **NOTE** 1st element is always an entry at time 0
-        for (uint32_t e = 2; e < MAX_POST_SYNAPTIC_EVENTS; e++) {
-            events->times[e - 1] = events->times[e];
-            events->traces[e - 1] = events->traces[e];
-        }
+        // If there's still space, increment count minus 1
+        events->count_minus_one++;
+    } else {
 
-        // Stick new time at end
-        events->times[MAX_POST_SYNAPTIC_EVENTS - 1] = time;
-        events->traces[MAX_POST_SYNAPTIC_EVENTS - 1] = trace;
+        // Otherwise drop the oldest event; the new event then goes where the
+        // placeholder was
+        _post_events_drop_oldest(events);
     }
+
+    // Stick new time at end
+    const uint32_t new_index =
+        _post_events_index(events, events->count_minus_one);
+#ifdef POST_EVENT_TIMES_COMPRESSED
+    events->times[new_index] = time - events->base_time;
+#else
+    events->times[new_index] = time;
+#endif
+    events->traces[new_index] = trace;
+}
+
+//---------------------------------------
+static inline uint32_t post_events_get_n_truncated_windows() {
+    return _post_events_n_truncated_windows;
 }
 
 #endif  // _POST_EVENTS_H_
@@ -19,6 +19,14 @@ uint32_t num_plastic_pre_synaptic_events;
 
 post_event_history_t *post_event_history;
 
+// The word following the plasticity parameters, which the host sets to
+// freeze plasticity
+static address_t plasticity_frozen_address;
+
+// True once plasticity has been frozen; this is never undone, as rows are
+// rewritten with fixed synapses as they are used
+static bool plasticity_frozen;
+
 //---------------------------------------
 // Synapse update loop
 //---------------------------------------
@@ -52,7 +60,7 @@ static inline final_state_t _plasticity_update_synapse(
         if (pre_valid
                 && (!post_valid
                         || (*pre_window.next_time + delay)
-                                <= *post_window.next_time)) {
+                                <= post_window.next_time)) {
             log_debug("\t\tApplying pre-synaptic event at time:%u",
                       *pre_window.next_time + delay);
 
@@ -69,14 +77,14 @@ static inline final_state_t _plasticity_update_synapse(
         // Otherwise, if the next post-synaptic event occurs before the next pre-synaptic event
         else if (post_valid
                 && (!pre_valid
-                        || *post_window.next_time
+                        || post_window.next_time
                                 <= (*pre_window.next_time + delay))) {
             log_debug("\t\tApplying post-synaptic event at time:%u",
-                      *post_window.next_time);
+                      post_window.next_time);
 
             // Apply spike to state
-            current_state = timing_apply_post_spike(*post_window.next_time,
-                    *post_window.next_trace, pre_window.prev_time,
+            current_state = timing_apply_post_spike(post_window.next_time,
+                    post_window.next_trace, pre_window.prev_time,
                     pre_window.prev_trace, post_window.prev_time,
                     post_window.prev_trace, current_state);
 
@@ -120,9 +128,12 @@ bool synapse_dynamics_initialise(
         address_t address, uint32_t n_neurons,
         uint32_t *ring_buffer_to_input_buffer_left_shifts) {
 
+    // Read the size of the post-synaptic event history
+    uint32_t max_post_events = address[0];
+
     // Load timing dependence data
-    address_t weight_region_address = timing_initialise(address);
-    if (address == NULL) {
+    address_t weight_region_address = timing_initialise(&address[1]);
+    if (weight_region_address == NULL) {
         return false;
     }
 
@@ -133,7 +144,11 @@ bool synapse_dynamics_initialise(
         return false;
     }
 
-    post_event_history = post_events_init_buffers(n_neurons);
+    plasticity_frozen_address = weight_result;
+    plasticity_frozen = false;
+    synapse_dynamics_resume();
+
+    post_event_history = post_events_init_buffers(n_neurons, max_post_events);
     if (post_event_history == NULL) {
         return false;
     }
@@ -143,12 +158,14 @@ bool synapse_dynamics_initialise(
 
 bool synapse_dynamics_process_plastic_synapses(
         address_t plastic_region_address, address_t fixed_region_address,
-        weight_t *ring_buffers, uint32_t time) {
+        weight_t *ring_buffers, uint32_t time,
+        uint32_t *n_plastic_words_changed) {
 
     // Extract separate arrays of plastic synapses (from plastic region),
     // Control words (from fixed region) and number of plastic synapses
     plastic_synapse_t *plastic_words = _plastic_synapses(
         plastic_region_address);
+    const plastic_synapse_t *changed_end = plastic_words;
     const control_t *control_words = synapse_row_plastic_controls(
         fixed_region_address);
     size_t plastic_synapse = synapse_row_num_plastic_controls(
@@ -200,11 +217,22 @@ bool synapse_dynamics_process_plastic_synapses(
         ring_buffers[ring_buffer_index] += synapse_structure_get_final_weight(
             final_state);
 
-        // Write back updated synaptic word to plastic region
-        *plastic_words++ = synapse_structure_get_final_synaptic_word(
-            final_state);
+        // Write back updated synaptic word to plastic region, noting if it
+        // has changed
+        const plastic_synapse_t final_word =
+            synapse_structure_get_final_synaptic_word(final_state);
+        if (final_word != *plastic_words) {
+            changed_end = plastic_words + 1;
+        }
+        *plastic_words++ = final_word;
     }
 
+    // The header always changes, so write back at least that, and any
+    // synaptic words up to the last one which changed
+    *n_plastic_words_changed =
+        (((uint32_t) changed_end) - ((uint32_t) plastic_region_address)
+            + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
     log_debug("Adding pre-synaptic event to trace at time:%u", time);
 
     // Add pre-event
@@ -216,15 +244,55 @@ bool synapse_dynamics_process_plastic_synapses(
     return true;
 }
 
+bool synapse_dynamics_freeze_plastic_synapses(
+        address_t plastic_region_address, address_t fixed_region_address,
+        uint32_t *fixed_synapses) {
+    const plastic_synapse_t *plastic_words = _plastic_synapses(
+        plastic_region_address);
+    const control_t *control_words = synapse_row_plastic_controls(
+        fixed_region_address);
+    size_t plastic_synapse = synapse_row_num_plastic_controls(
+        fixed_region_address);
+
+    for (; plastic_synapse > 0; plastic_synapse--) {
+        uint32_t control_word = *control_words++;
+
+        // The weight is the one left by the last update of the synapse; any
+        // post-synaptic events since then are not applied to it
+        update_state_t state = synapse_structure_get_update_state(
+            *plastic_words++, synapse_row_sparse_type(control_word));
+        weight_t weight = synapse_structure_get_final_weight(
+            synapse_structure_get_final_state(state));
+        *fixed_synapses++ = synapse_row_fixed_synapse(weight, control_word);
+    }
+    return true;
+}
+
+bool synapse_dynamics_is_plasticity_frozen() {
+    return plasticity_frozen;
+}
+
+void synapse_dynamics_resume() {
+    if (!plasticity_frozen && plasticity_frozen_address[0] != 0) {
+        log_info("Plasticity frozen");
+        plasticity_frozen = true;
+    }
+}
+
 void synapse_dynamics_process_post_synaptic_event(
         uint32_t time, index_t neuron_index) {
+
+    // Once frozen, nothing uses the post-synaptic event history
+    if (plasticity_frozen) {
+        return;
+    }
+
     log_debug("Adding post-synaptic event to trace at time:%u", time);
 
     // Add post-event
     post_event_history_t *history = &post_event_history[neuron_index];
-    const uint32_t last_post_time = history->times[history->count_minus_one];
-    const post_trace_t last_post_trace =
-        history->traces[history->count_minus_one];
+    const uint32_t last_post_time = post_events_get_last_time(history);
+    const post_trace_t last_post_trace = post_events_get_last_trace(history);
     post_events_add(time, history, timing_add_post_spike(time, last_post_time,
                                                          last_post_trace));
 }
@@ -289,3 +357,11 @@ uint32_t synapse_dynamics_get_plastic_pre_synaptic_events(){
     return 0;
 #endif  // SYNAPSE_BENCHMARK
 }
+
+//! \brief returns the number of plastic synapse updates which should have
+//!        included post-synaptic events that had already been dropped from
+//!        the post-synaptic event history
+//! \return the number of updates
+uint32_t synapse_dynamics_get_n_truncated_post_windows() {
+    return post_events_get_n_truncated_windows();
+}
@@ -21,33 +21,26 @@
 // Macros
 //---------------------------------------
 // The plastic control words used by Morrison synapses store an axonal delay
-// in the upper 3 bits.
-// Assuming a maximum of 16 delay slots, this is all that is required as:
-//
-// 1) Dendritic + Axonal <= 15
-// 2) Dendritic >= Axonal
-//
-// Therefore:
-//
-// * Maximum value of dendritic delay is 15 (with axonal delay of 0)
-//    - It requires 4 bits
-// * Maximum value of axonal delay is 7 (with dendritic delay of 8)
-//    - It requires 3 bits
+// in the bits of the 16-bit control word above the dendritic delay.
+// The axonal delay is not currently used (it is always 0), so it only gets
+// whatever bits the dendritic delay, which can be up to SYNAPSE_DELAY_BITS
+// wide, leaves.
 //
 // |        Axonal delay       |  Dendritic delay   |       Type        |      Index         |
 // |---------------------------|--------------------|-------------------|--------------------|
 // | SYNAPSE_AXONAL_DELAY_BITS | SYNAPSE_DELAY_BITS | SYNAPSE_TYPE_BITS | SYNAPSE_INDEX_BITS |
 // |                           |                    |        SYNAPSE_TYPE_INDEX_BITS         |
 // |---------------------------|--------------------|----------------------------------------|
+#define SYNAPSE_DELAY_TYPE_INDEX_BITS \
+    (SYNAPSE_DELAY_BITS + SYNAPSE_TYPE_INDEX_BITS)
+
+// By default, the axonal delay takes whatever is left of the control word
 #ifndef SYNAPSE_AXONAL_DELAY_BITS
-#define SYNAPSE_AXONAL_DELAY_BITS 3
+#define SYNAPSE_AXONAL_DELAY_BITS (16 - SYNAPSE_DELAY_TYPE_INDEX_BITS)
 #endif
 
 #define SYNAPSE_AXONAL_DELAY_MASK ((1 << SYNAPSE_AXONAL_DELAY_BITS) - 1)
 
-#define SYNAPSE_DELAY_TYPE_INDEX_BITS \
-    (SYNAPSE_DELAY_BITS + SYNAPSE_TYPE_INDEX_BITS)
-
 #if (SYNAPSE_DELAY_TYPE_INDEX_BITS + SYNAPSE_AXONAL_DELAY_BITS) > 16
 #error "Not enough bits for axonal synaptic delay bits"
 #endif
@@ -62,6 +55,18 @@ typedef struct {
 
 post_event_history_t *post_event_history;
 
+// The position in each post-synaptic event history where the last window
+// requested from it started
+static uint8_t *post_window_cache;
+
+// The word following the plasticity parameters, which the host sets to
+// freeze plasticity
+static address_t plasticity_frozen_address;
+
+// True once plasticity has been frozen; this is never undone, as rows are
+// rewritten with fixed synapses as they are used
+static bool plasticity_frozen;
+
 //---------------------------------------
 // Synapse update loop
 //---------------------------------------
@@ -70,16 +75,33 @@ static inline final_state_t _plasticity_update_synapse(
         const uint32_t last_pre_time, const pre_trace_t last_pre_trace,
         const pre_trace_t new_pre_trace, const uint32_t delay_dendritic,
         const uint32_t delay_axonal, update_state_t current_state,
-        const post_event_history_t *post_event_history) {
+        const post_event_history_t *post_event_history,
+        uint8_t *post_window_start) {
 
-    // Apply axonal delay to time of last presynaptic spike
+    // Apply axonal delay to time of last and new presynaptic spikes
     const uint32_t delayed_last_pre_time = last_pre_time + delay_axonal;
+    const uint32_t delayed_pre_time = time + delay_axonal;
 
-    // Get the post-synaptic window of events to be processed
+    // If the post-synaptic neuron hasn't spiked since the start of the window
+    // there are no events to process, so only the pre-synaptic spike applies
     const uint32_t window_begin_time = delayed_last_pre_time - delay_dendritic;
+    const uint32_t last_post_time = post_events_get_last_time(
+        post_event_history);
+    if (last_post_time <= window_begin_time) {
+        log_debug("\tPerforming pre-synaptic only update at time:%u", time);
+
+        current_state = timing_apply_pre_spike(
+            delayed_pre_time, new_pre_trace, delayed_last_pre_time,
+            last_pre_trace, last_post_time,
+            post_events_get_last_trace(post_event_history), current_state);
+        return synapse_structure_get_final_state(current_state);
+    }
+
+    // Get the post-synaptic window of events to be processed
     const uint32_t window_end_time = time + delay_axonal - delay_dendritic;
-    post_event_window_t post_window = post_events_get_window_delayed(
-            post_event_history, window_begin_time, window_end_time);
+    post_event_window_t post_window = post_events_get_window_delayed_cached(
+            post_event_history, window_begin_time, window_end_time,
+            post_window_start);
 
     log_debug("\tPerforming deferred synapse update at time:%u", time);
     log_debug("\t\tbegin_time:%u, end_time:%u - prev_time:%u, num_events:%u",
@@ -88,14 +110,14 @@ static inline final_state_t _plasticity_update_synapse(
 
     // Process events in post-synaptic window
     while (post_window.num_events > 0) {
-        const uint32_t delayed_post_time = *post_window.next_time
+        const uint32_t delayed_post_time = post_window.next_time
                                            + delay_dendritic;
         log_debug("\t\tApplying post-synaptic event at delayed time:%u\n",
               delayed_post_time);
 
         // Apply spike to state
         current_state = timing_apply_post_spike(
-            delayed_post_time, *post_window.next_trace, delayed_last_pre_time,
+            delayed_post_time, post_window.next_trace, delayed_last_pre_time,
             last_pre_trace, post_window.prev_time, post_window.prev_trace,
             current_state);
 
@@ -103,7 +125,6 @@ static inline final_state_t _plasticity_update_synapse(
         post_window = post_events_next_delayed(post_window, delayed_post_time);
     }
 
-    const uint32_t delayed_pre_time = time + delay_axonal;
     log_debug("\t\tApplying pre-synaptic event at time:%u last post time:%u\n",
               delayed_pre_time, post_window.prev_time);
 
@@ -188,9 +209,12 @@ bool synapse_dynamics_initialise(
         address_t address, uint32_t n_neurons,
         uint32_t *ring_buffer_to_input_buffer_left_shifts) {
 
+    // Read the size of the post-synaptic event history
+    uint32_t max_post_events = address[0];
+
     // Load timing dependence data
-    address_t weight_region_address = timing_initialise(address);
-    if (address == NULL) {
+    address_t weight_region_address = timing_initialise(&address[1]);
+    if (weight_region_address == NULL) {
         return false;
     }
 
@@ -201,22 +225,98 @@ bool synapse_dynamics_initialise(
         return false;
     }
 
-    post_event_history = post_events_init_buffers(n_neurons);
+    // The window cache stores positions in the history as bytes
+    if (max_post_events > 256) {
+        log_error("Post-synaptic event history size %u is more than 256",
+                  max_post_events);
+        return false;
+    }
+
+    plasticity_frozen_address = weight_result;
+    plasticity_frozen = false;
+    synapse_dynamics_resume();
+
+    post_event_history = post_events_init_buffers(n_neurons, max_post_events);
     if (post_event_history == NULL) {
         return false;
     }
 
+    post_window_cache = (uint8_t*) spin1_malloc(n_neurons * sizeof(uint8_t));
+    if (post_window_cache == NULL) {
+        log_error("Unable to allocate post-synaptic window cache");
+        return false;
+    }
+    for (uint32_t n = 0; n < n_neurons; n++) {
+        post_window_cache[n] = 0;
+    }
+
     return true;
 }
 
+//---------------------------------------
+// Updates a plastic synapse, adds its weight to the ring buffers and returns
+// its new synaptic word
+static inline plastic_synapse_t _process_plastic_synapse(
+        uint32_t control_word, plastic_synapse_t plastic_word, uint32_t time,
+        const uint32_t last_pre_time, const pre_trace_t last_pre_trace,
+        const pre_trace_t new_pre_trace, weight_t *ring_buffers) {
+
+    // Extract control-word components
+    // **NOTE** cunningly, control word is just the same as lower
+    // 16-bits of 32-bit fixed synapse so same functions can be used
+    uint32_t delay_axonal = 0;    //_sparse_axonal_delay(control_word);
+    uint32_t delay_dendritic = synapse_row_sparse_delay(control_word);
+    uint32_t type = synapse_row_sparse_type(control_word);
+    uint32_t index = synapse_row_sparse_index(control_word);
+    uint32_t type_index = synapse_row_sparse_type_index(control_word);
+
+    // Convert into ring buffer offset
+    uint32_t ring_buffer_index = synapses_get_ring_buffer_index_combined(
+            delay_axonal + delay_dendritic + time, type_index);
+
+    // If the post-synaptic neuron hasn't spiked since the start of the window
+    // and the pre-synaptic spike doesn't depress the synapse, the synaptic
+    // word is unchanged, so there is no need to build an update state
+    const post_event_history_t *history = &post_event_history[index];
+    const uint32_t last_post_time = post_events_get_last_time(history);
+    if ((last_post_time <= last_pre_time + delay_axonal - delay_dendritic)
+            && timing_is_pre_spike_null(
+                time + delay_axonal, last_post_time,
+                post_events_get_last_trace(history))) {
+        ring_buffers[ring_buffer_index] += synapse_structure_get_weight(
+            plastic_word);
+        return plastic_word;
+    }
+
+    // Create update state from the plastic synaptic word
+    update_state_t current_state = synapse_structure_get_update_state(
+        plastic_word, type);
+
+    // Update the synapse state
+    final_state_t final_state = _plasticity_update_synapse(
+        time, last_pre_time, last_pre_trace, new_pre_trace,
+        delay_dendritic, delay_axonal, current_state,
+        history, &post_window_cache[index]);
+
+    // Add weight to ring-buffer entry
+    // **NOTE** Dave suspects that this could be a
+    // potential location for overflow
+    ring_buffers[ring_buffer_index] += synapse_structure_get_final_weight(
+        final_state);
+
+    return synapse_structure_get_final_synaptic_word(final_state);
+}
+
 bool synapse_dynamics_process_plastic_synapses(
         address_t plastic_region_address, address_t fixed_region_address,
-        weight_t *ring_buffers, uint32_t time) {
+        weight_t *ring_buffers, uint32_t time,
+        uint32_t *n_plastic_words_changed) {
 
     // Extract separate arrays of plastic synapses (from plastic region),
     // Control words (from fixed region) and number of plastic synapses
     plastic_synapse_t *plastic_words = _plastic_synapses(
         plastic_region_address);
+    const plastic_synapse_t *changed_end = plastic_words;
     const control_t *control_words = synapse_row_plastic_controls(
         fixed_region_address);
     size_t plastic_synapse = synapse_row_num_plastic_controls(
@@ -240,57 +340,111 @@ bool synapse_dynamics_process_plastic_synapses(
     event_history->prev_trace = timing_add_pre_spike(time, last_pre_time,
                                                      last_pre_trace);
 
-    // Loop through plastic synapses
+#ifdef PLASTIC_SYNAPSE_LOADS_PAIRED
+
+    // The control words and the plastic synapses are parallel arrays of
+    // half-words which both start on a word boundary, so the synapses can be
+    // processed in pairs, loading and storing two of each at once
+    static_assert(sizeof(plastic_synapse_t) == sizeof(control_t),
+                  "Plastic synapses can only be processed in pairs if they"
+                  " are the same size as the control words");
+    const uint32_t *control_pairs = (const uint32_t *) control_words;
+    uint32_t *plastic_pairs = (uint32_t *) plastic_words;
+    for (; plastic_synapse >= 2; plastic_synapse -= 2) {
+        const uint32_t controls = *control_pairs++;
+        const uint32_t words = *plastic_pairs;
+
+        // **NOTE** the first of each pair is in the lower half-word
+        const uint16_t first_word = _process_plastic_synapse(
+            controls & 0xFFFF, words & 0xFFFF, time, last_pre_time,
+            last_pre_trace, event_history->prev_trace, ring_buffers);
+        const uint16_t second_word = _process_plastic_synapse(
+            controls >> 16, words >> 16, time, last_pre_time,
+            last_pre_trace, event_history->prev_trace, ring_buffers);
+        const uint32_t final_words =
+            ((uint32_t) first_word) | (((uint32_t) second_word) << 16);
+        if (final_words != words) {
+            changed_end = (const plastic_synapse_t *) (plastic_pairs + 1);
+        }
+        *plastic_pairs++ = final_words;
+    }
+    control_words = (const control_t *) control_pairs;
+    plastic_words = (plastic_synapse_t *) plastic_pairs;
+#endif // PLASTIC_SYNAPSE_LOADS_PAIRED
+
+    // Loop through (any remaining) plastic synapses
     for (; plastic_synapse > 0; plastic_synapse--) {
 
-        // Get next control word (auto incrementing)
+        // Get next control word (auto incrementing) and update the synapse
+        const plastic_synapse_t final_word = _process_plastic_synapse(
+            *control_words++, *plastic_words, time, last_pre_time,
+            last_pre_trace, event_history->prev_trace, ring_buffers);
+
+        // Write back updated synaptic word to plastic region, noting if it
+        // has changed
+        if (final_word != *plastic_words) {
+            changed_end = plastic_words + 1;
+        }
+        *plastic_words++ = final_word;
+    }
+
+    // The header always changes, so write back at least that, and any
+    // synaptic words up to the last one which changed
+    *n_plastic_words_changed =
+        (((uint32_t) changed_end) - ((uint32_t) plastic_region_address)
+            + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    return true;
+}
+
+bool synapse_dynamics_freeze_plastic_synapses(
+        address_t plastic_region_address, address_t fixed_region_address,
+        uint32_t *fixed_synapses) {
+    const plastic_synapse_t *plastic_words = _plastic_synapses(
+        plastic_region_address);
+    const control_t *control_words = synapse_row_plastic_controls(
+        fixed_region_address);
+    size_t plastic_synapse = synapse_row_num_plastic_controls(
+        fixed_region_address);
+
+    for (; plastic_synapse > 0; plastic_synapse--) {
         uint32_t control_word = *control_words++;
 
-        // Extract control-word components
-        // **NOTE** cunningly, control word is just the same as lower
-        // 16-bits of 32-bit fixed synapse so same functions can be used
-        uint32_t delay_axonal = 0;    //_sparse_axonal_delay(control_word);
-        uint32_t delay_dendritic = synapse_row_sparse_delay(control_word);
-        uint32_t type = synapse_row_sparse_type(control_word);
-        uint32_t index = synapse_row_sparse_index(control_word);
-        uint32_t type_index = synapse_row_sparse_type_index(control_word);
-
-        // Create update state from the plastic synaptic word
-        update_state_t current_state = synapse_structure_get_update_state(
-            *plastic_words, type);
-
-        // Update the synapse state
-        final_state_t final_state = _plasticity_update_synapse(
-            time, last_pre_time, last_pre_trace, event_history->prev_trace,
-            delay_dendritic, delay_axonal, current_state,
-            &post_event_history[index]);
-
-        // Convert into ring buffer offset
-        uint32_t ring_buffer_index = synapses_get_ring_buffer_index_combined(
-                delay_axonal + delay_dendritic + time, type_index);
-
-        // Add weight to ring-buffer entry
-        // **NOTE** Dave suspects that this could be a
-        // potential location for overflow
-        ring_buffers[ring_buffer_index] += synapse_structure_get_final_weight(
-            final_state);
-
-        // Write back updated synaptic word to plastic region
-        *plastic_words++ = synapse_structure_get_final_synaptic_word(
-            final_state);
+        // The weight is the one left by the last update of the synapse; any
+        // post-synaptic events since then are not applied to it
+        update_state_t state = synapse_structure_get_update_state(
+            *plastic_words++, synapse_row_sparse_type(control_word));
+        weight_t weight = synapse_structure_get_final_weight(
+            synapse_structure_get_final_state(state));
+        *fixed_synapses++ = synapse_row_fixed_synapse(weight, control_word);
     }
     return true;
 }
 
+bool synapse_dynamics_is_plasticity_frozen() {
+    return plasticity_frozen;
+}
+
+void synapse_dynamics_resume() {
+    if (!plasticity_frozen && plasticity_frozen_address[0] != 0) {
+        log_info("Plasticity frozen");
+        plasticity_frozen = true;
+    }
+}
+
 void synapse_dynamics_process_post_synaptic_event(
         uint32_t time, index_t neuron_index) {
+
+    // Once frozen, nothing uses the post-synaptic event history
+    if (plasticity_frozen) {
+        return;
+    }
+
     log_debug("Adding post-synaptic event to trace at time:%u", time);
 
     // Add post-event
     post_event_history_t *history = &post_event_history[neuron_index];
-    const uint32_t last_post_time = history->times[history->count_minus_one];
-    const post_trace_t last_post_trace =
-        history->traces[history->count_minus_one];
+    const uint32_t last_post_time = post_events_get_last_time(history);
+    const post_trace_t last_post_trace = post_events_get_last_trace(history);
     post_events_add(time, history, timing_add_post_spike(time, last_post_time,
                                                          last_post_trace));
 }
@@ -308,3 +462,11 @@ uint32_t synapse_dynamics_get_plastic_pre_synaptic_events(){
     return 0;
 #endif  // SYNAPSE_BENCHMARK
 }
+
+//! \brief returns the number of plastic synapse updates which should have
+//!        included post-synaptic events that had already been dropped from
+//!        the post-synaptic event history
+//! \return the number of updates
+uint32_t synapse_dynamics_get_n_truncated_post_windows() {
+    return post_events_get_n_truncated_windows();
+}
@@ -6,6 +6,8 @@
 static update_state_t synapse_structure_get_update_state(
         plastic_synapse_t synaptic_word, index_t synapse_type);
 
+static weight_t synapse_structure_get_weight(plastic_synapse_t synaptic_word);
+
 static final_state_t synapse_structure_get_final_state(
         update_state_t state);
 
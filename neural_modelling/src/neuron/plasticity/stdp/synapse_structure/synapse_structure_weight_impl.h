@@ -22,6 +22,12 @@ static inline update_state_t synapse_structure_get_update_state(
     return weight_get_initial(synaptic_word, synapse_type);
 }
 
+//---------------------------------------
+static inline weight_t synapse_structure_get_weight(
+        plastic_synapse_t synaptic_word) {
+    return synaptic_word;
+}
+
 //---------------------------------------
 static inline final_state_t synapse_structure_get_final_state(
         update_state_t state) {
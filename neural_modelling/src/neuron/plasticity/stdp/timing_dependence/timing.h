@@ -13,6 +13,11 @@ static post_trace_t timing_add_post_spike(uint32_t time, uint32_t last_time,
 static pre_trace_t timing_add_pre_spike(uint32_t time, uint32_t last_time,
                                         pre_trace_t last_trace);
 
+// True if a pre-synaptic spike at time would leave the weight unchanged,
+// given the last post-synaptic spike before it
+static bool timing_is_pre_spike_null(
+    uint32_t time, uint32_t last_post_time, post_trace_t last_post_trace);
+
 static update_state_t timing_apply_pre_spike(
     uint32_t time, pre_trace_t trace, uint32_t last_pre_time,
     pre_trace_t last_pre_trace,  uint32_t last_post_time,
@@ -4,8 +4,8 @@
 // Globals
 //---------------------------------------
 // Exponential lookup-tables
-int16_t tau_plus_lookup[TAU_PLUS_SIZE];
-int16_t tau_minus_lookup[TAU_MINUS_SIZE];
+exp_lut_t tau_plus_lookup;
+exp_lut_t tau_minus_lookup;
 
 //---------------------------------------
 // Functions
@@ -16,11 +16,12 @@ address_t timing_initialise(address_t address) {
     log_info("\tSTDP pair rule");
     // **TODO** assert number of neurons is less than max
 
-    // Copy LUTs from following memory
-    address_t lut_address = maths_copy_int16_lut(&address[0], TAU_PLUS_SIZE,
-                                                 &tau_plus_lookup[0]);
-    lut_address = maths_copy_int16_lut(lut_address, TAU_MINUS_SIZE,
-                                       &tau_minus_lookup[0]);
+    // Read LUTs from following memory
+    exp_lut_t *luts[] = {&tau_plus_lookup, &tau_minus_lookup};
+    address_t lut_address = maths_read_exp_luts(&address[0], 2, luts);
+    if (lut_address == NULL) {
+        return NULL;
+    }
 
     log_info("timing_initialise: completed successfully");
 
@@ -21,26 +21,17 @@ typedef int16_t pre_trace_t;
 //---------------------------------------
 // Macros
 //---------------------------------------
-// Exponential decay lookup parameters
-#define TAU_PLUS_TIME_SHIFT 0
-#define TAU_PLUS_SIZE 256
-
-#define TAU_MINUS_TIME_SHIFT 0
-#define TAU_MINUS_SIZE 256
-
 // Helper macros for looking up decays
 #define DECAY_LOOKUP_TAU_PLUS(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_PLUS_TIME_SHIFT, TAU_PLUS_SIZE, tau_plus_lookup)
+    maths_lut_exponential_decay(time, &tau_plus_lookup)
 #define DECAY_LOOKUP_TAU_MINUS(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_MINUS_TIME_SHIFT, TAU_MINUS_SIZE, tau_minus_lookup)
+    maths_lut_exponential_decay(time, &tau_minus_lookup)
 
 //---------------------------------------
 // Externals
 //---------------------------------------
-extern int16_t tau_plus_lookup[TAU_PLUS_SIZE];
-extern int16_t tau_minus_lookup[TAU_MINUS_SIZE];
+extern exp_lut_t tau_plus_lookup;
+extern exp_lut_t tau_minus_lookup;
 
 //---------------------------------------
 // Timing dependence inline functions
@@ -92,6 +83,14 @@ static inline pre_trace_t timing_add_pre_spike(
     return (pre_trace_t) new_r1_trace;
 }
 
+//---------------------------------------
+static inline bool timing_is_pre_spike_null(
+        uint32_t time, uint32_t last_post_time, post_trace_t last_post_trace) {
+    uint32_t time_since_last_post = time - last_post_time;
+    return (time_since_last_post == 0) || (STDP_FIXED_MUL_16X16(
+        last_post_trace, DECAY_LOOKUP_TAU_MINUS(time_since_last_post)) == 0);
+}
+
 //---------------------------------------
 static inline update_state_t timing_apply_pre_spike(
         uint32_t time, pre_trace_t trace, uint32_t last_pre_time,
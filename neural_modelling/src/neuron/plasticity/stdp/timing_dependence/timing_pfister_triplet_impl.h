@@ -28,41 +28,24 @@ typedef struct pre_trace_t {
 //---------------------------------------
 // Macros
 //---------------------------------------
-// Exponential decay lookup parameters
-#define TAU_PLUS_TIME_SHIFT 0
-#define TAU_PLUS_SIZE 256
-
-#define TAU_MINUS_TIME_SHIFT 0
-#define TAU_MINUS_SIZE 256
-
-#define TAU_X_TIME_SHIFT 2
-#define TAU_X_SIZE 256
-
-#define TAU_Y_TIME_SHIFT 2
-#define TAU_Y_SIZE 256
-
 // Helper macros for looking up decays
 #define DECAY_LOOKUP_TAU_PLUS(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_PLUS_TIME_SHIFT, TAU_PLUS_SIZE, tau_plus_lookup)
+    maths_lut_exponential_decay(time, &tau_plus_lookup)
 #define DECAY_LOOKUP_TAU_MINUS(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_MINUS_TIME_SHIFT, TAU_MINUS_SIZE, tau_minus_lookup)
+    maths_lut_exponential_decay(time, &tau_minus_lookup)
 
 #define DECAY_LOOKUP_TAU_X(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_X_TIME_SHIFT, TAU_X_SIZE, tau_x_lookup)
+    maths_lut_exponential_decay(time, &tau_x_lookup)
 #define DECAY_LOOKUP_TAU_Y(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_Y_TIME_SHIFT, TAU_Y_SIZE, tau_y_lookup)
+    maths_lut_exponential_decay(time, &tau_y_lookup)
 
 //---------------------------------------
 // Externals
 //---------------------------------------
-extern int16_t tau_plus_lookup[TAU_PLUS_SIZE];
-extern int16_t tau_minus_lookup[TAU_MINUS_SIZE];
-extern int16_t tau_x_lookup[TAU_X_SIZE];
-extern int16_t tau_y_lookup[TAU_Y_SIZE];
+extern exp_lut_t tau_plus_lookup;
+extern exp_lut_t tau_minus_lookup;
+extern exp_lut_t tau_x_lookup;
+extern exp_lut_t tau_y_lookup;
 
 //---------------------------------------
 // Timing dependence inline functions
@@ -125,6 +108,17 @@ static inline pre_trace_t timing_add_pre_spike(
     return (pre_trace_t) {.r1 = new_r1, .r2 = new_r2};
 }
 
+//---------------------------------------
+static inline bool timing_is_pre_spike_null(
+        uint32_t time, uint32_t last_post_time, post_trace_t last_post_trace) {
+
+    // The triplet term is scaled by o1, so is null whenever o1 is
+    uint32_t time_since_last_post = time - last_post_time;
+    return (time_since_last_post == 0) || (STDP_FIXED_MUL_16X16(
+        last_post_trace.o1,
+        DECAY_LOOKUP_TAU_MINUS(time_since_last_post)) == 0);
+}
+
 //---------------------------------------
 static inline update_state_t timing_apply_pre_spike(
         uint32_t time, pre_trace_t trace, uint32_t last_pre_time,
@@ -8,9 +8,33 @@ bool synapse_dynamics_initialise(
     address_t address, uint32_t n_neurons,
     uint32_t *ring_buffer_to_input_buffer_left_shifts);
 
+//! \brief processes the plastic synapses of a row
+//! \param[out] n_plastic_words_changed The number of words from the start of
+//!                                     the plastic region which include all
+//!                                     of the changes made to it
+//! \return false if the row could not be processed
 bool synapse_dynamics_process_plastic_synapses(
     address_t plastic_region_address, address_t fixed_region_address,
-    weight_t *ring_buffers, uint32_t time);
+    weight_t *ring_buffers, uint32_t time,
+    uint32_t *n_plastic_words_changed);
+
+//! \brief converts the plastic synapses of a row into fixed synaptic words,
+//!        each with the weight the synapse currently has
+//! \param[out] fixed_synapses Updated with a fixed synaptic word for each
+//!                            plastic synapse, in the same order
+//! \return false if the row could not be converted
+bool synapse_dynamics_freeze_plastic_synapses(
+    address_t plastic_region_address, address_t fixed_region_address,
+    uint32_t *fixed_synapses);
+
+//! \brief determines if the host has asked for plasticity to be frozen; once
+//!        frozen, rows with plastic synapses should be converted with
+//!        synapse_dynamics_freeze_plastic_synapses when they are next used
+//! \return true if plasticity is frozen
+bool synapse_dynamics_is_plasticity_frozen();
+
+//! \brief re-reads any settings the host may have changed between runs
+void synapse_dynamics_resume();
 
 void synapse_dynamics_process_post_synaptic_event(
     uint32_t time, index_t neuron_index);
@@ -27,4 +51,10 @@ void synapse_dynamics_print_plastic_synapses(
 //! \return counters for plastic pre synaptic events or 0
 uint32_t synapse_dynamics_get_plastic_pre_synaptic_events();
 
+//! \brief returns the number of plastic synapse updates which should have
+//!        included post-synaptic events that had already been dropped from
+//!        the post-synaptic event history
+//! \return the number of updates, or 0 if there is no plasticity
+uint32_t synapse_dynamics_get_n_truncated_post_windows();
+
 #endif // _SYNAPSE_DYNAMICS_H_
@@ -19,16 +19,37 @@ void synapse_dynamics_process_post_synaptic_event(
 
 //---------------------------------------
 bool synapse_dynamics_process_plastic_synapses(address_t plastic_region_address,
-        address_t fixed_region_address, weight_t *ring_buffer, uint32_t time) {
+        address_t fixed_region_address, weight_t *ring_buffer, uint32_t time,
+        uint32_t *n_plastic_words_changed) {
     use(plastic_region_address);
     use(fixed_region_address);
     use(ring_buffer);
     use(time);
+    use(n_plastic_words_changed);
 
     log_error("There should be no plastic synapses!");
     return false;
 }
 
+//---------------------------------------
+bool synapse_dynamics_freeze_plastic_synapses(
+        address_t plastic_region_address, address_t fixed_region_address,
+        uint32_t *fixed_synapses) {
+    use(plastic_region_address);
+    use(fixed_region_address);
+    use(fixed_synapses);
+
+    log_error("There should be no plastic synapses!");
+    return false;
+}
+
+bool synapse_dynamics_is_plasticity_frozen() {
+    return false;
+}
+
+void synapse_dynamics_resume() {
+}
+
 //---------------------------------------
 input_t synapse_dynamics_get_intrinsic_bias(uint32_t time, index_t neuron_index) {
     use(time);
@@ -47,3 +68,7 @@ void synapse_dynamics_print_plastic_synapses(
 uint32_t synapse_dynamics_get_plastic_pre_synaptic_events() {
     return 0;
 }
+
+uint32_t synapse_dynamics_get_n_truncated_post_windows() {
+    return 0;
+}
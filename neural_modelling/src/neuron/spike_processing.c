@@ -3,7 +3,9 @@
 #include "synapse_row.h"
 #include "synapses.h"
 #include "../common/in_spikes.h"
+#include "../common/profiler.h"
 #include <spin1_api.h>
+#include <sark.h>
 #include <debug.h>
 
 // The number of DMA Buffers to use
@@ -25,9 +27,24 @@ typedef struct dma_buffer {
 
     uint32_t n_bytes_transferred;
 
+    // The number of words at the start of the plastic region which have
+    // changed and so need to be written back
+    uint32_t n_plastic_words_changed;
+
+    // The number of words at the start of the row which have been rewritten
+    // and so need to be written back in place of the whole row
+    uint32_t n_row_words_rewritten;
+
     // Row data
     uint32_t *row;
 
+    // True from when the row starts to be read until it has been processed
+    bool in_flight;
+
+    // True if the row was in flight at the start of a timer tick, and so is
+    // part of the late backlog
+    bool late;
+
 } dma_buffer;
 
 extern uint32_t time;
@@ -35,6 +52,9 @@ extern uint32_t time;
 // True if the DMA "loop" is currently running
 static bool dma_busy;
 
+// The number of write backs of rows started but not yet complete
+static uint32_t n_writes_in_flight;
+
 // The DTCM buffers for the synapse rows
 static dma_buffer dma_buffers[N_DMA_BUFFERS];
 
@@ -48,8 +68,69 @@ static uint32_t max_n_words;
 
 static spike_t spike;
 
+// The number of timer ticks that have started
+static uint32_t n_timer_ticks;
+
+// The number of spikes received before the last timer tick that are still to
+// be taken from the input buffer
+static uint32_t n_late_spikes_pending;
+
+// The number of rows in flight at the last timer tick that are still to be
+// processed
+static uint32_t n_late_buffers_pending;
+
+// The timer tick at the start of which the current late spikes were pending
+static uint32_t late_since_tick;
+
+// The number of spikes taken from the input buffer after the end of the tick
+// they arrived in
+static uint32_t n_late_spikes;
+
+// The longest time in cycles between a tick ending and the backlog of spikes
+// at the end of it being cleared
+static uint32_t max_late_cycles;
+
 /* PRIVATE FUNCTIONS - static for inlining */
 
+//! \brief measures the lateness of the backlog of the last timer tick if it
+//!        has just been cleared
+static inline void _check_late_backlog_cleared() {
+    if (n_late_spikes_pending > 0 || n_late_buffers_pending > 0) {
+        return;
+    }
+
+    // The timer counts down from the period loaded into it
+    uint32_t timer_period_cycles = tc[T1_LOAD];
+    uint32_t late_cycles =
+        ((n_timer_ticks - late_since_tick) * timer_period_cycles) +
+        (timer_period_cycles - tc[T1_COUNT]);
+    if (late_cycles > max_late_cycles) {
+        max_late_cycles = late_cycles;
+    }
+}
+
+//! \brief counts a spike taken from the input buffer, which is late if it
+//!        was received before the last timer tick; each spike is counted
+//!        once, however many rows it has and whether or not it has any
+static inline void _count_dequeued_spike() {
+    if (n_late_spikes_pending > 0) {
+        n_late_spikes++;
+        n_late_spikes_pending--;
+        _check_late_backlog_cleared();
+    }
+}
+
+//! \brief notes that the row in a buffer has been processed
+//! \param[in] buffer The buffer
+static inline void _count_processed_buffer(dma_buffer *buffer) {
+    buffer->in_flight = false;
+    if (buffer->late) {
+        buffer->late = false;
+        n_late_buffers_pending--;
+        _check_late_backlog_cleared();
+    }
+}
+
 static inline void _do_dma_read(
         address_t row_address, size_t n_bytes_to_transfer) {
 
@@ -59,6 +140,9 @@ static inline void _do_dma_read(
     next_buffer->sdram_writeback_address = row_address;
     next_buffer->originating_spike = spike;
     next_buffer->n_bytes_transferred = n_bytes_to_transfer;
+    next_buffer->n_plastic_words_changed = 0;
+    next_buffer->n_row_words_rewritten = 0;
+    next_buffer->in_flight = true;
 
     // Start a DMA transfer to fetch this synaptic row into current
     // buffer
@@ -84,6 +168,7 @@ static inline void _setup_synaptic_dma_read() {
     uint32_t setup_done = false;
     while (!setup_done && in_spikes_get_next_spike(&spike)) {
         log_debug("Checking for row for spike 0x%.8x\n", spike);
+        _count_dequeued_spike();
 
         // Decode spike to get address of destination synaptic row
         if (population_table_get_first_address(
@@ -106,15 +191,34 @@ static inline void _setup_synaptic_dma_write(uint32_t dma_buffer_index) {
     // Get pointer to current buffer
     dma_buffer *buffer = &dma_buffers[dma_buffer_index];
 
-    // Get the number of plastic bytes and the write back address from the
-    // synaptic row
+    // If the row has been rewritten, write back the new row
+    if (buffer->n_row_words_rewritten > 0) {
+        log_debug("Writing back %u words of rewritten row to %08x",
+                  buffer->n_row_words_rewritten,
+                  buffer->sdram_writeback_address);
+        n_writes_in_flight++;
+        spin1_dma_transfer(
+            DMA_TAG_WRITE_PLASTIC_REGION, buffer->sdram_writeback_address,
+            buffer->row, DMA_WRITE,
+            buffer->n_row_words_rewritten * sizeof(uint32_t));
+        return;
+    }
+
+    // Get the number of plastic bytes which have changed; if nothing has,
+    // there is no need to write anything back
     size_t n_plastic_region_bytes =
-        synapse_row_plastic_size(buffer->row) * sizeof(uint32_t);
+        buffer->n_plastic_words_changed * sizeof(uint32_t);
+    if (n_plastic_region_bytes == 0) {
+        return;
+    }
 
-    log_debug("Writing back %u bytes of plastic region to %08x",
-              n_plastic_region_bytes, buffer->sdram_writeback_address + 1);
+    log_debug("Writing back %u of %u bytes of plastic region to %08x",
+              n_plastic_region_bytes,
+              synapse_row_plastic_size(buffer->row) * sizeof(uint32_t),
+              buffer->sdram_writeback_address + 1);
 
     // Start transfer
+    n_writes_in_flight++;
     spin1_dma_transfer(
         DMA_TAG_WRITE_PLASTIC_REGION, buffer->sdram_writeback_address + 1,
         synapse_row_plastic_region(buffer->row),
@@ -169,6 +273,8 @@ void _dma_complete_callback(uint unused, uint tag) {
         uint32_t current_buffer_index = buffer_being_read;
         dma_buffer *current_buffer = &dma_buffers[current_buffer_index];
 
+        profiler_start(PROFILER_DMA_ROW);
+
         // Start the next DMA transfer, so it is complete when we are finished
         _setup_synaptic_dma_read();
 
@@ -180,6 +286,9 @@ void _dma_complete_callback(uint unused, uint tag) {
             // neuron?
             subsequent_spikes = in_spikes_is_next_spike_equal(
                 current_buffer->originating_spike);
+            if (subsequent_spikes) {
+                _count_dequeued_spike();
+            }
 
             // Process synaptic row, writing it back if it's the last time
             // it's going to be processed
@@ -202,10 +311,13 @@ void _dma_complete_callback(uint unused, uint tag) {
                 rt_error(RTE_SWERR);
             }
         } while (subsequent_spikes);
+        _count_processed_buffer(current_buffer);
+
+        profiler_end(PROFILER_DMA_ROW);
 
     } else if (tag == DMA_TAG_WRITE_PLASTIC_REGION) {
 
-        // Do Nothing
+        n_writes_in_flight--;
 
     } else {
 
@@ -232,8 +344,16 @@ bool spike_processing_initialise(
         }
         log_info(
             "DMA buffer %u allocated at 0x%08x", (uint32_t) dma_buffers[i].row);
+        dma_buffers[i].in_flight = false;
+        dma_buffers[i].late = false;
     }
     dma_busy = false;
+    n_writes_in_flight = 0;
+    n_timer_ticks = 0;
+    n_late_spikes_pending = 0;
+    n_late_buffers_pending = 0;
+    n_late_spikes = 0;
+    max_late_cycles = 0;
     next_buffer_to_fill = 0;
     buffer_being_read = N_DMA_BUFFERS;
     max_n_words = row_max_n_words;
@@ -253,6 +373,18 @@ bool spike_processing_initialise(
     return true;
 }
 
+void spike_processing_plastic_words_changed(
+        uint32_t process_id, uint32_t n_words) {
+    dma_buffer *buffer = &dma_buffers[process_id];
+    if (n_words > buffer->n_plastic_words_changed) {
+        buffer->n_plastic_words_changed = n_words;
+    }
+}
+
+void spike_processing_row_rewritten(uint32_t process_id, uint32_t n_words) {
+    dma_buffers[process_id].n_row_words_rewritten = n_words;
+}
+
 void spike_processing_finish_write(uint32_t process_id) {
     _setup_synaptic_dma_write(process_id);
 }
@@ -264,3 +396,42 @@ uint32_t spike_processing_get_buffer_overflows() {
     // Check for buffer overflow
     return in_spikes_get_n_buffer_overflows();
 }
+
+void spike_processing_timer_tick() {
+    uint32_t state = spin1_irq_disable();
+
+    // The backlog is the spikes still waiting in the input buffer and the
+    // rows being read or waiting to be processed; if there was already a
+    // backlog, the lateness continues from the tick it started in
+    n_timer_ticks++;
+    if (n_late_spikes_pending == 0 && n_late_buffers_pending == 0) {
+        late_since_tick = n_timer_ticks;
+    }
+    n_late_spikes_pending = in_spikes_size();
+    n_late_buffers_pending = 0;
+    for (uint32_t i = 0; i < N_DMA_BUFFERS; i++) {
+        dma_buffers[i].late = dma_buffers[i].in_flight;
+        if (dma_buffers[i].late) {
+            n_late_buffers_pending++;
+        }
+    }
+
+    spin1_mode_restore(state);
+}
+
+void spike_processing_wait_for_idle() {
+
+    // The DMA and user event callbacks interrupt this loop, so the spikes
+    // and rows are dealt with as normal
+    while (dma_busy || n_writes_in_flight > 0 || in_spikes_size() > 0) {
+        spin1_delay_us(1);
+    }
+}
+
+uint32_t spike_processing_get_n_late_spikes() {
+    return n_late_spikes;
+}
+
+uint32_t spike_processing_get_max_lateness_us() {
+    return max_late_cycles / sv->cpu_clk;
+}
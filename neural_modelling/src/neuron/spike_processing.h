@@ -8,10 +8,46 @@ bool spike_processing_initialise(
     uint dma_trasnfer_callback_priority, uint user_event_priority,
     uint incoming_spike_buffer_size);
 
+//! \brief notes that part of the plastic region of the row in a DMA buffer
+//!        has changed; the region is written back from its start to the end
+//!        of the last change seen since the row was read
+//! \param[in] process_id The index of the DMA buffer holding the row
+//! \param[in] n_words The number of words from the start of the plastic
+//!                    region which have changed
+void spike_processing_plastic_words_changed(
+    uint32_t process_id, uint32_t n_words);
+
+//! \brief notes that the row in a DMA buffer has been rewritten; the start
+//!        of the row is then written back in place of the plastic region
+//! \param[in] process_id The index of the DMA buffer holding the row
+//! \param[in] n_words The number of words from the start of the row to
+//!                    write back
+void spike_processing_row_rewritten(uint32_t process_id, uint32_t n_words);
+
 void spike_processing_finish_write(uint32_t process_id);
 
 //! \brief returns the number of times the input buffer has overflowed
 //! \return the number of times the input buffer has overflowed
 uint32_t spike_processing_get_buffer_overflows();
 
+//! \brief notes the start of a timer tick; any spikes received before this
+//!        which have not yet been taken from the input buffer are counted as
+//!        late, and they and any rows in flight make up the late backlog
+void spike_processing_timer_tick();
+
+//! \brief waits until the spikes in the input buffer have been processed and
+//!        the rows they changed have been written back to SDRAM; the DMA and
+//!        user event callbacks must be able to interrupt the caller
+void spike_processing_wait_for_idle();
+
+//! \brief returns the number of spikes taken from the input buffer after the
+//!        end of the timer tick in which they were received
+//! \return the number of late spikes
+uint32_t spike_processing_get_n_late_spikes();
+
+//! \brief returns the longest time from the end of a timer tick to the
+//!        clearing of the late backlog at the end of it
+//! \return the worst lateness in microseconds
+uint32_t spike_processing_get_max_lateness_us();
+
 #endif // _SPIKE_PROCESSING_H_
@@ -20,6 +20,7 @@
  * - synapse_row_sparse_type_index(x)
  * - synapse_row_sparse_delay(x)
  * - synapse_row_sparse_weight(x)
+ * - synapse_row_fixed_synapse(weight, control)
  *  */
 
 #ifndef _SYNAPSE_ROW_H_
@@ -32,9 +33,10 @@
 #define SYNAPSE_WEIGHT_BITS 16
 #endif
 
-//! how many bits the synapse delay will take
+//! how many bits the synapse delay will take; the ring buffers may use
+//! fewer of these, as set by the host (see synapses_initialise)
 #ifndef SYNAPSE_DELAY_BITS
-#define SYNAPSE_DELAY_BITS 4
+#define SYNAPSE_DELAY_BITS 6
 #endif
 
 #ifndef SYNAPSE_TYPE_BITS
@@ -167,4 +169,13 @@ static inline weight_t synapse_row_sparse_weight(uint32_t x) {
     return (x >> (32 - SYNAPSE_WEIGHT_BITS));
 }
 
+// Makes a fixed synaptic word from a weight and a plastic synapse control word;
+// any bits of the control word above the delay are dropped
+static inline uint32_t synapse_row_fixed_synapse(
+        weight_t weight, uint32_t control) {
+    return ((((uint32_t) weight) << (32 - SYNAPSE_WEIGHT_BITS)) |
+            (control & ((1 << (SYNAPSE_DELAY_BITS + SYNAPSE_TYPE_INDEX_BITS))
+                        - 1)));
+}
+
 #endif  // SYNAPSE_ROW_H
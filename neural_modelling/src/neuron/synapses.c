@@ -6,10 +6,8 @@
 #include <spin1_api.h>
 #include <string.h>
 
-// Compute the size of the input buffers and ring buffers
+// Compute the size of the input buffers
 #define INPUT_BUFFER_SIZE (1 << (SYNAPSE_TYPE_BITS + SYNAPSE_INDEX_BITS))
-#define RING_BUFFER_SIZE (1 << (SYNAPSE_DELAY_BITS + SYNAPSE_TYPE_BITS\
-                                + SYNAPSE_INDEX_BITS))
 
 // Globals required for synapse benchmarking to work.
 #ifdef SYNAPSE_BENCHMARK
@@ -20,7 +18,11 @@
 static uint32_t n_neurons;
 
 // Ring buffers to handle delays between synapses and neurons
-static weight_t ring_buffers[RING_BUFFER_SIZE];
+static weight_t *ring_buffers;
+
+// The layout of the ring buffers (see synapses_get_ring_buffer_index)
+uint32_t synapses_ring_buffer_delay_bits;
+uint32_t synapses_ring_buffer_delay_mask;
 
 // Amount to left shift the ring buffer by to make it an input
 static uint32_t ring_buffer_to_input_left_shifts[SYNAPSE_TYPE_COUNT];
@@ -34,6 +36,31 @@ static synapse_param_t *neuron_synapse_shaping_params;
 // Count of the number of times the ring buffers have saturated
 static uint32_t saturation_count = 0;
 
+// Space to convert the plastic synapses of a row into fixed synapses once
+// plasticity is frozen, or to get their weights at the end of a run;
+// allocated when the first row is converted
+static uint32_t *frozen_synapses = NULL;
+
+// The most synapses a row can contain; the host does not make longer rows
+#define MAX_SYNAPSES_PER_ROW 256
+
+// The region into which the weights of the plastic synapses are written at the
+// end of each run, and the synaptic matrix region they are read from:
+// - the number of blocks of rows
+// - the number of weights written at the end of the last run (0 until written)
+// - for each block, the offset of the block from the start of the synaptic
+//   matrix in words, the number of rows and the number of words in each row
+// - the 16-bit weights, for each block in turn, of each row in turn, in the
+//   order of the synapses in the row
+static address_t plastic_weights_region = NULL;
+static address_t synaptic_matrix_region;
+
+// The layout of the plastic weights region
+#define PLASTIC_WEIGHTS_N_BLOCKS 0
+#define PLASTIC_WEIGHTS_N_WEIGHTS 1
+#define PLASTIC_WEIGHTS_HEADER_WORDS 2
+#define PLASTIC_WEIGHTS_BLOCK_WORDS 3
+
 
 /* PRIVATE FUNCTIONS */
 
@@ -96,13 +123,15 @@ static inline void _print_ring_buffers(uint32_t time) {
         for (uint32_t t = 0; t < SYNAPSE_TYPE_COUNT; t++) {
             const char *type_string = synapse_types_get_type_char(t);
             bool empty = true;
-            for (uint32_t d = 0; d < (1 << SYNAPSE_DELAY_BITS); d++) {
+            for (uint32_t d = 0; d < (1 << synapses_ring_buffer_delay_bits);
+                    d++) {
                 empty = empty && (ring_buffers[
                     synapses_get_ring_buffer_index(d + time, t, n)] == 0);
             }
             if (!empty) {
                 log_debug("%3d(%s):", n, type_string);
-                for (uint32_t d = 0; d < (1 << SYNAPSE_DELAY_BITS); d++) {
+                for (uint32_t d = 0;
+                        d < (1 << synapses_ring_buffer_delay_bits); d++) {
                     log_debug(" ");
                     uint32_t ring_buffer_index =
                         synapses_get_ring_buffer_index(d + time, t, n);
@@ -198,6 +227,107 @@ static inline void _process_fixed_synapses(
     }
 }
 
+// Allocates the space used to convert plastic synapses to fixed synapses
+static inline bool _allocate_frozen_synapses() {
+    if (frozen_synapses == NULL) {
+        frozen_synapses = (uint32_t *) spin1_malloc(
+            MAX_SYNAPSES_PER_ROW * sizeof(uint32_t));
+        if (frozen_synapses == NULL) {
+            log_error("Unable to allocate space to convert plastic rows");
+            return false;
+        }
+    }
+    return true;
+}
+
+// Checks that the plastic synapses of a row fit in the space used to convert
+// them
+static inline bool _check_n_plastic_synapses(uint32_t n_plastic) {
+    if (n_plastic > MAX_SYNAPSES_PER_ROW) {
+        log_error("Row has %u plastic synapses, but at most %u are supported",
+                  n_plastic, MAX_SYNAPSES_PER_ROW);
+        return false;
+    }
+    return true;
+}
+
+// Rewrites a row with a plastic region in place as a row with only fixed
+// synapses, with the plastic synapses keeping the weights they have now, and
+// starts writing it back; the row is then processed as a fixed row whenever
+// it is used again
+static inline bool _freeze_plastic_row(
+        synaptic_row_t row, uint32_t process_id) {
+    if (!_allocate_frozen_synapses()) {
+        return false;
+    }
+
+    // Convert the plastic synapses before anything is moved over them
+    address_t fixed_region_address = synapse_row_fixed_region(row);
+    uint32_t n_fixed = synapse_row_num_fixed_synapses(fixed_region_address);
+    uint32_t n_plastic = synapse_row_num_plastic_controls(
+        fixed_region_address);
+    if (!_check_n_plastic_synapses(n_plastic)) {
+        return false;
+    }
+    if (!synapse_dynamics_freeze_plastic_synapses(
+            synapse_row_plastic_region(row), fixed_region_address,
+            frozen_synapses)) {
+        return false;
+    }
+
+    // Move the fixed synapses down to follow an empty plastic region
+    // **NOTE** the plastic region is at least one word, so the fixed
+    // synapses only ever move towards the start of the row
+    uint32_t *fixed_synapses = synapse_row_fixed_weight_controls(
+        fixed_region_address);
+    uint32_t *new_synapses = &row[N_SYNAPSE_ROW_HEADER_WORDS];
+    for (uint32_t i = 0; i < n_fixed; i++) {
+        *new_synapses++ = *fixed_synapses++;
+    }
+    for (uint32_t i = 0; i < n_plastic; i++) {
+        *new_synapses++ = frozen_synapses[i];
+    }
+    row[0] = 0;
+    row[1] = n_fixed + n_plastic;
+    row[2] = 0;
+
+    spike_processing_row_rewritten(
+        process_id, N_SYNAPSE_ROW_HEADER_WORDS + n_fixed + n_plastic);
+    spike_processing_finish_write(process_id);
+    return true;
+}
+
+// Writes the weights of the synapses of a row in a block of plastic rows,
+// returning the number written, or -1 if the row could not be read; a row
+// with an empty plastic region has been frozen, and has the weights in its
+// fixed synapses instead
+static inline int32_t _write_plastic_row_weights(
+        synaptic_row_t row, weight_t *weights) {
+    address_t fixed_region_address = synapse_row_fixed_region(row);
+    uint32_t *synapses;
+    uint32_t n_synapses;
+    if (synapse_row_plastic_size(row) == 0) {
+        synapses = synapse_row_fixed_weight_controls(fixed_region_address);
+        n_synapses = synapse_row_num_fixed_synapses(fixed_region_address);
+    } else {
+        n_synapses = synapse_row_num_plastic_controls(fixed_region_address);
+        if (!_check_n_plastic_synapses(n_synapses)) {
+            return -1;
+        }
+        if (!synapse_dynamics_freeze_plastic_synapses(
+                synapse_row_plastic_region(row), fixed_region_address,
+                frozen_synapses)) {
+            return -1;
+        }
+        synapses = frozen_synapses;
+    }
+
+    for (uint32_t i = 0; i < n_synapses; i++) {
+        weights[i] = synapse_row_sparse_weight(synapses[i]);
+    }
+    return n_synapses;
+}
+
 //! private method for doing output debug data on the synapses
 static inline void _print_synapse_parameters() {
 //! only if the models are compiled in debug mode will this method contain
@@ -227,9 +357,6 @@ bool synapses_initialise(address_t address, uint32_t n_neurons_value,
     for (uint32_t i = 0; i < INPUT_BUFFER_SIZE; i++) {
         input_buffers[i] = 0;
     }
-    for (uint32_t i = 0; i < RING_BUFFER_SIZE; i++) {
-        ring_buffers[i] = 0;
-    }
 
     // Get the synapse shaping data
     if (sizeof(synapse_param_t) > 0) {
@@ -268,11 +395,108 @@ bool synapses_initialise(address_t address, uint32_t n_neurons_value,
     }
     *ring_buffer_to_input_buffer_left_shifts = ring_buffer_to_input_left_shifts;
 
+    // Get the number of delay bits of the ring buffers
+    synapses_ring_buffer_delay_bits = address[
+        ring_buffer_input_left_shifts_base + SYNAPSE_TYPE_COUNT];
+    if (synapses_ring_buffer_delay_bits > SYNAPSE_DELAY_BITS) {
+        log_error("Ring buffer delay bits %u exceeds the %u delay bits of a"
+                  " synapse", synapses_ring_buffer_delay_bits,
+                  SYNAPSE_DELAY_BITS);
+        return false;
+    }
+    synapses_ring_buffer_delay_mask =
+        (1 << synapses_ring_buffer_delay_bits) - 1;
+    if (n_neurons > (1 << SYNAPSE_INDEX_BITS)) {
+        log_error("%u neurons exceeds the %u neurons a synapse can target",
+                  n_neurons, 1 << SYNAPSE_INDEX_BITS);
+        return false;
+    }
+
+    // Allocate the ring buffers, with the delay slots of the last synapse
+    // type ending after the last neuron
+    uint32_t ring_buffer_size = ((((SYNAPSE_TYPE_COUNT - 1)
+                                   << SYNAPSE_INDEX_BITS)
+                                  + n_neurons)
+                                 << synapses_ring_buffer_delay_bits);
+    ring_buffers = (weight_t *) spin1_malloc(
+        ring_buffer_size * sizeof(weight_t));
+    if (ring_buffers == NULL) {
+        log_error("Cannot allocate %u ring buffer entries - Out of DTCM",
+                  ring_buffer_size);
+        return false;
+    }
+    for (uint32_t i = 0; i < ring_buffer_size; i++) {
+        ring_buffers[i] = 0;
+    }
+    log_info("ring buffers of %u delay slots",
+             1 << synapses_ring_buffer_delay_bits);
+
     log_info("synapses_initialise: completed successfully");
     _print_synapse_parameters();
     return true;
 }
 
+void synapses_initialise_plastic_weights(
+        address_t plastic_weights_region_value,
+        address_t synaptic_matrix_region_value) {
+    plastic_weights_region = plastic_weights_region_value;
+    synaptic_matrix_region = synaptic_matrix_region_value;
+    if (plastic_weights_region != NULL) {
+        log_info("Writing plastic weights of %u blocks at the end of each run",
+                 plastic_weights_region[PLASTIC_WEIGHTS_N_BLOCKS]);
+        synapses_invalidate_plastic_weights();
+    }
+}
+
+bool synapses_has_plastic_weights() {
+    return plastic_weights_region != NULL;
+}
+
+void synapses_write_plastic_weights() {
+    if (plastic_weights_region == NULL) {
+        return;
+    }
+
+    // The synapses of each row are converted in the same way as when they are
+    // frozen, to get the weights they have now
+    if (!_allocate_frozen_synapses()) {
+        return;
+    }
+
+    uint32_t n_blocks = plastic_weights_region[PLASTIC_WEIGHTS_N_BLOCKS];
+    address_t blocks = &plastic_weights_region[PLASTIC_WEIGHTS_HEADER_WORDS];
+    weight_t *weights = (weight_t *) &blocks[
+        n_blocks * PLASTIC_WEIGHTS_BLOCK_WORDS];
+    uint32_t n_weights = 0;
+    for (uint32_t block = 0; block < n_blocks; block++) {
+        synaptic_row_t row = &synaptic_matrix_region[blocks[0]];
+        uint32_t n_rows = blocks[1];
+        uint32_t n_row_words = blocks[2];
+        for (uint32_t i = 0; i < n_rows; i++) {
+            int32_t n_row_weights = _write_plastic_row_weights(
+                row, &weights[n_weights]);
+            if (n_row_weights < 0) {
+                log_error("Unable to read the weights of row %u of block %u",
+                          i, block);
+                return;
+            }
+            n_weights += n_row_weights;
+            row += n_row_words;
+        }
+        blocks += PLASTIC_WEIGHTS_BLOCK_WORDS;
+    }
+
+    // Only now are the weights complete
+    plastic_weights_region[PLASTIC_WEIGHTS_N_WEIGHTS] = n_weights;
+    log_info("Wrote %u plastic weights", n_weights);
+}
+
+void synapses_invalidate_plastic_weights() {
+    if (plastic_weights_region != NULL) {
+        plastic_weights_region[PLASTIC_WEIGHTS_N_WEIGHTS] = 0;
+    }
+}
+
 void synapses_do_timestep_update(timer_t time) {
 
     _print_ring_buffers(time);
@@ -327,6 +551,16 @@ bool synapses_process_synaptic_row(uint32_t time, synaptic_row_t row,
     // **TODO** multiple optimised synaptic row formats
     //if (plastic_tag(row) == 0)
     //{
+    // If this row has a plastic region, but plasticity has been frozen, the
+    // row becomes a row of fixed synapses
+    if ((synapse_row_plastic_size(row) > 0) &&
+            synapse_dynamics_is_plasticity_frozen()) {
+        if (!_freeze_plastic_row(row, process_id)) {
+            return false;
+        }
+        fixed_region_address = synapse_row_fixed_region(row);
+    }
+
     // If this row has a plastic region
     if (synapse_row_plastic_size(row) > 0) {
 
@@ -334,10 +568,14 @@ bool synapses_process_synaptic_row(uint32_t time, synaptic_row_t row,
         address_t plastic_region_address = synapse_row_plastic_region(row);
 
         // Process any plastic synapses
+        uint32_t n_plastic_words_changed;
         if (!synapse_dynamics_process_plastic_synapses(plastic_region_address,
-                fixed_region_address, ring_buffers, time)) {
+                fixed_region_address, ring_buffers, time,
+                &n_plastic_words_changed)) {
             return false;
         }
+        spike_processing_plastic_words_changed(
+            process_id, n_plastic_words_changed);
 
         // Perform DMA write back
         if (write) {
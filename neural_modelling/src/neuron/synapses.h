@@ -4,24 +4,33 @@
 #include "../common/neuron-typedefs.h"
 #include "synapse_row.h"
 
+//! The number of bits of the time step used to index the ring buffers, which
+//! limits the delay supported without a delay extension; set by the host
+//! (see synapses_initialise) to at most SYNAPSE_DELAY_BITS
+extern uint32_t synapses_ring_buffer_delay_bits;
+
+//! The mask of the time step bits used to index the ring buffers
+extern uint32_t synapses_ring_buffer_delay_mask;
+
+// Get the index of the ring buffer for a given timestep and combined
+// synapse type and neuron index (as stored in a synapse row); the delay
+// slots of each synapse type and neuron are contiguous, so the index is just
+// the combined index shifted up by the delay bits, and the ring buffers need
+// only end after the last neuron on this core
+static inline index_t synapses_get_ring_buffer_index_combined(
+        uint32_t simulation_timestep, uint32_t combined_synapse_neuron_index) {
+    return ((combined_synapse_neuron_index << synapses_ring_buffer_delay_bits)
+            | (simulation_timestep & synapses_ring_buffer_delay_mask));
+}
+
 // Get the index of the ring buffer for a given timestep, synapse type and
 // neuron index
 static inline index_t synapses_get_ring_buffer_index(
         uint32_t simuation_timestep, uint32_t synapse_type_index,
         uint32_t neuron_index) {
-    return (((simuation_timestep & SYNAPSE_DELAY_MASK)
-             << SYNAPSE_TYPE_INDEX_BITS)
-            | (synapse_type_index << SYNAPSE_INDEX_BITS)
-            | neuron_index);
-}
-
-// Get the index of the ring buffer for a given timestep and combined
-// synapse type and neuron index (as stored in a synapse row)
-static inline index_t synapses_get_ring_buffer_index_combined(
-        uint32_t simulation_timestep, uint32_t combined_synapse_neuron_index) {
-    return (((simulation_timestep & SYNAPSE_DELAY_MASK)
-             << SYNAPSE_TYPE_INDEX_BITS)
-            | combined_synapse_neuron_index);
+    return synapses_get_ring_buffer_index_combined(
+        simuation_timestep,
+        (synapse_type_index << SYNAPSE_INDEX_BITS) | neuron_index);
 }
 
 // Converts a weight stored in a synapse row to an input
@@ -49,6 +58,29 @@ bool synapses_initialise(address_t address, uint32_t n_neurons,
                          input_t **input_buffers_value,
                          uint32_t **ring_buffer_to_input_buffer_left_shifts);
 
+//! \brief sets up the writing of the weights of the plastic synapses at the
+//!        end of each run; see synapses_write_plastic_weights
+//! \param[in] plastic_weights_region The region to write the weights to, or
+//!                                   NULL if there are no plastic synapses
+//! \param[in] synaptic_matrix_region The region containing the synaptic rows
+void synapses_initialise_plastic_weights(
+    address_t plastic_weights_region, address_t synaptic_matrix_region);
+
+//! \brief determines if the weights of plastic synapses are written at the
+//!        end of each run
+//! \return true if synapses_write_plastic_weights writes any weights
+bool synapses_has_plastic_weights();
+
+//! \brief writes the current weights of the plastic synapses in the blocks of
+//!        rows listed in the plastic weights region contiguously into the
+//!        region, so that the host can read the weights without reading the
+//!        rows
+void synapses_write_plastic_weights();
+
+//! \brief marks the weights written by synapses_write_plastic_weights as
+//!        out of date, e.g. when the simulation is resumed
+void synapses_invalidate_plastic_weights();
+
 void synapses_do_timestep_update(timer_t time);
 
 bool synapses_process_synaptic_row(uint32_t time, synaptic_row_t row,
@@ -0,0 +1,511 @@
+/*! \file
+ *
+ *  \brief This file contains the main functions for a spike source array
+ *         which plays back spikes stored in SDRAM by the host.
+ *
+ *  \details The spikes are stored as a stream of 16-bit halfwords packed into
+ *           words, least significant half first.  The stream is a sequence
+ *           of blocks, one for each time step in which any source spikes, in
+ *           order of time step.  Each block is the number of time steps since
+ *           the previous block (or since time step 0 for the first block), the
+ *           number of spikes in the time step and then the index of each
+ *           spiking source, as the difference from the previous index in the
+ *           block (or from 0 for the first index).  Each of these values is
+ *           written as one or more halfwords holding 15 bits of the value
+ *           each, least significant first, with the top bit set in all but
+ *           the last halfword.
+ *
+ *           The stream is read in chunks, each of which is copied to DTCM by
+ *           DMA while the one before it is read, so that the spikes of a time
+ *           step are read without waiting for SDRAM.
+ */
+
+#include "../../common/out_spikes.h"
+
+#include <data_specification.h>
+#include <recording.h>
+#include <debug.h>
+#include <simulation.h>
+#include <spin1_api.h>
+
+//! spike source array region ids in human readable form
+typedef enum region {
+    SYSTEM, SPIKE_SOURCE_ARRAY_PARAMS,
+    BUFFERING_OUT_SPIKE_RECORDING_REGION,
+    BUFFERING_OUT_CONTROL_REGION,
+    PROVENANCE_REGION, SPIKE_DATA_REGION
+} region;
+
+#define NUMBER_OF_REGIONS_TO_RECORD 1
+
+typedef enum callback_priorities{
+    SDP_AND_DMA = 0, TIMER = 2
+} callback_priorities;
+
+//! what each position in the spike source array parameter region actually
+//! represent in terms of data (each is a word)
+typedef enum spike_source_array_region_parameters{
+    HAS_KEY, TRANSMISSION_KEY, N_SPIKE_SOURCES
+} spike_source_array_region_parameters;
+
+//! what each position in the spike data region represents; the stream of
+//! halfwords starts after the number of halfwords in it
+typedef enum spike_data_region_parameters{
+    N_STREAM_HALFWORDS, STREAM_START_POSITION
+} spike_data_region_parameters;
+
+//! entries in the provenance data region after the common entries
+typedef enum extra_provenance_data_region_entries{
+    N_CHUNKS_PREFETCHED = 0,
+    N_DIRECT_STREAM_READS = 1
+} extra_provenance_data_region_entries;
+
+//! The tag of the DMA transfers which copy the chunks of the stream to DTCM
+#define DMA_TAG_READ_SPIKE_DATA 0
+
+//! The number of words in each chunk of the stream, as a power of 2
+#define SPIKE_DATA_CHUNK_WORDS_SHIFT 8
+#define SPIKE_DATA_CHUNK_WORDS (1 << SPIKE_DATA_CHUNK_WORDS_SHIFT)
+
+//! The number of DTCM buffers into which the chunks are copied
+#define N_CHUNK_BUFFERS 2
+
+//! The chunk number of a buffer holding no chunk
+#define NO_CHUNK UINT32_MAX
+
+//! The bits of each halfword of the stream holding part of a value, and the
+//! bit which marks that more of the value follows
+#define STREAM_VALUE_BITS 15
+#define STREAM_VALUE_MASK 0x7FFF
+#define STREAM_CONTINUE_BIT 0x8000
+
+// Globals
+//! the stream of spikes in SDRAM, its length in halfwords and in words
+static uint32_t *stream_data;
+static uint32_t n_stream_halfwords = 0;
+static uint32_t n_stream_words = 0;
+
+//! the position in the stream of the next halfword to read
+static uint32_t stream_position = 0;
+
+//! the chunk of the stream being read, which is the one after which the next
+//! chunk is prefetched
+static uint32_t current_chunk = NO_CHUNK;
+
+//! the buffers of chunks of the stream in DTCM, the chunk in each, whether
+//! each has been filled, whether a DMA is filling a buffer, which buffer it
+//! is filling, and whether a prefetch was put off until it finishes
+static uint32_t chunk_buffers[N_CHUNK_BUFFERS][SPIKE_DATA_CHUNK_WORDS];
+static uint32_t buffer_chunk[N_CHUNK_BUFFERS];
+static volatile bool buffer_ready[N_CHUNK_BUFFERS];
+static volatile bool dma_busy = false;
+static uint32_t dma_buffer = 0;
+static volatile bool prefetch_pending = false;
+
+//! the time step of the next block of the stream; UINT32_MAX if there are no
+//! more
+static uint32_t next_spike_tick = 0;
+
+//! Counts of the chunks prefetched by DMA and of the words read directly from
+//! SDRAM as the chunk holding them had not been copied in time, for
+//! provenance
+static uint32_t n_chunks_prefetched = 0;
+static uint32_t n_direct_stream_reads = 0;
+
+//! the number of sources
+static uint32_t num_spike_sources = 0;
+
+//! a variable which checks if there has been a key allocated to this spike
+//! source array
+static bool has_been_given_key;
+
+//! A variable that contains the key value that this model should transmit with
+static uint32_t key;
+
+//! keeps track of which types of recording should be done to this model.
+static uint32_t recording_flags = 0;
+
+//! the time interval parameter TODO this variable could be removed and use the
+//! timer tick callback timer value.
+static uint32_t time;
+
+//! the number of timer ticks that this model should run for before exiting.
+static uint32_t simulation_ticks = 0;
+
+//! the int that represents the bool for if the run is infinite or not.
+static uint32_t infinite_run;
+
+//! \brief starts copying the chunk after the given one to DTCM, unless it is
+//!        past the end of the stream; if a copy is already in progress, this
+//!        is put off until it finishes
+//! \param[in] chunk the chunk which is now being read
+static void _prefetch_next_chunk(uint32_t chunk) {
+    uint32_t next_chunk = chunk + 1;
+    uint32_t first_word = next_chunk << SPIKE_DATA_CHUNK_WORDS_SHIFT;
+    if (first_word >= n_stream_words) {
+        return;
+    }
+
+    // Interrupts are disabled so that the copy in progress cannot finish
+    // between checking it and putting this one off
+    uint32_t state = spin1_irq_disable();
+    if (dma_busy) {
+        prefetch_pending = true;
+        spin1_mode_restore(state);
+        return;
+    }
+    dma_busy = true;
+    spin1_mode_restore(state);
+
+    uint32_t n_words = n_stream_words - first_word;
+    if (n_words > SPIKE_DATA_CHUNK_WORDS) {
+        n_words = SPIKE_DATA_CHUNK_WORDS;
+    }
+
+    // The buffer of the chunk before the one being read is no longer needed
+    uint32_t buffer = next_chunk & (N_CHUNK_BUFFERS - 1);
+    buffer_chunk[buffer] = next_chunk;
+    buffer_ready[buffer] = false;
+    dma_buffer = buffer;
+    if (spin1_dma_transfer(
+            DMA_TAG_READ_SPIKE_DATA, &stream_data[first_word],
+            chunk_buffers[buffer], DMA_READ,
+            n_words * sizeof(uint32_t)) == FAILURE) {
+        buffer_chunk[buffer] = NO_CHUNK;
+        dma_busy = false;
+        return;
+    }
+    n_chunks_prefetched++;
+}
+
+//! \brief reads the next halfword of the stream, from the buffer holding its
+//!        chunk if it has been copied, or otherwise directly from SDRAM
+//! \return the halfword
+static inline uint32_t _read_stream_halfword() {
+    uint32_t word_index = stream_position >> 1;
+    uint32_t chunk = word_index >> SPIKE_DATA_CHUNK_WORDS_SHIFT;
+    if (chunk != current_chunk) {
+        current_chunk = chunk;
+        _prefetch_next_chunk(chunk);
+    }
+
+    uint32_t buffer = chunk & (N_CHUNK_BUFFERS - 1);
+    uint32_t word;
+    if (buffer_chunk[buffer] == chunk && buffer_ready[buffer]) {
+        word = chunk_buffers[buffer][
+            word_index & (SPIKE_DATA_CHUNK_WORDS - 1)];
+    } else {
+        word = stream_data[word_index];
+        n_direct_stream_reads++;
+    }
+
+    uint32_t halfword = (stream_position & 1) ? (word >> 16) : (word & 0xFFFF);
+    stream_position++;
+    return halfword;
+}
+
+//! \brief reads the next value of the stream
+//! \return the value
+static inline uint32_t _read_stream_value() {
+    uint32_t value = 0;
+    uint32_t shift = 0;
+    uint32_t halfword;
+    do {
+        halfword = _read_stream_halfword();
+        value |= (halfword & STREAM_VALUE_MASK) << shift;
+        shift += STREAM_VALUE_BITS;
+    } while (halfword & STREAM_CONTINUE_BIT);
+    return value;
+}
+
+//! \brief reads the time step of the next block of the stream, if there is
+//!        one, into next_spike_tick
+static inline void _read_next_spike_tick() {
+    if (stream_position < n_stream_halfwords) {
+        next_spike_tick += _read_stream_value();
+    } else {
+        next_spike_tick = UINT32_MAX;
+    }
+}
+
+//! \brief DMA complete callback; marks the buffer being filled as ready, and
+//!        starts any prefetch put off while it was being filled
+//! \param[in] unused unused parameter kept for API consistency
+//! \param[in] tag the tag of the transfer which completed
+void dma_complete_callback(uint unused, uint tag) {
+    use(unused);
+    if (tag == DMA_TAG_READ_SPIKE_DATA) {
+        buffer_ready[dma_buffer] = true;
+        dma_busy = false;
+        if (prefetch_pending) {
+            prefetch_pending = false;
+            _prefetch_next_chunk(current_chunk);
+        }
+    }
+}
+
+//! \brief method for reading the parameters stored in the spike source array
+//!        parameter region and the start of the spike data region
+//! \param[in] address the absolute SDRAM memory address at which the spike
+//!            source array parameter region starts
+//! \param[in] spike_data_address the absolute SDRAM memory address at which
+//!            the spike data region starts
+//! \return a boolean which is True if the parameters were read successfully
+//!         or False otherwise
+static bool read_spike_source_array_parameters(
+        address_t address, address_t spike_data_address) {
+
+    log_info("read_parameters: starting");
+
+    has_been_given_key = address[HAS_KEY];
+    key = address[TRANSMISSION_KEY];
+    num_spike_sources = address[N_SPIKE_SOURCES];
+    log_info("\t key = %08x, spike sources = %u", key, num_spike_sources);
+
+    n_stream_halfwords = spike_data_address[N_STREAM_HALFWORDS];
+    n_stream_words = (n_stream_halfwords + 1) >> 1;
+    stream_data = &spike_data_address[STREAM_START_POSITION];
+    log_info("\t spike stream of %u halfwords", n_stream_halfwords);
+
+    // Copy the first chunks now, filling the buffers, so that only the later
+    // chunks are prefetched, which starts when the second chunk is reached
+    for (uint32_t b = 0; b < N_CHUNK_BUFFERS; b++) {
+        buffer_chunk[b] = NO_CHUNK;
+        buffer_ready[b] = false;
+        uint32_t first_word = b << SPIKE_DATA_CHUNK_WORDS_SHIFT;
+        if (first_word < n_stream_words) {
+            uint32_t n_words = n_stream_words - first_word;
+            if (n_words > SPIKE_DATA_CHUNK_WORDS) {
+                n_words = SPIKE_DATA_CHUNK_WORDS;
+            }
+            spin1_memcpy(chunk_buffers[b], &stream_data[first_word],
+                         n_words * sizeof(uint32_t));
+            buffer_chunk[b] = b;
+            buffer_ready[b] = true;
+        }
+    }
+    current_chunk = 0;
+
+    // Find the time step of the first block
+    stream_position = 0;
+    next_spike_tick = 0;
+    _read_next_spike_tick();
+
+    log_info("read_parameters: completed successfully");
+    return true;
+}
+
+//! \brief Initialises the recording parts of the model
+//! \return True if recording initialisation is successful, false otherwise
+static bool initialise_recording(){
+
+    // Get the address this core's DTCM data starts at from SRAM
+    address_t address = data_specification_get_data_address();
+
+    // Get the system region
+    address_t system_region = data_specification_get_region(
+            SYSTEM, address);
+
+    // Get the recording information
+    uint8_t regions_to_record[] = {
+        BUFFERING_OUT_SPIKE_RECORDING_REGION,
+    };
+    uint8_t n_regions_to_record = NUMBER_OF_REGIONS_TO_RECORD;
+    uint32_t *recording_flags_from_system_conf =
+        &system_region[SIMULATION_N_TIMING_DETAIL_WORDS];
+    uint8_t state_region = BUFFERING_OUT_CONTROL_REGION;
+
+    bool success = recording_initialize(
+        n_regions_to_record, regions_to_record,
+        recording_flags_from_system_conf, state_region, 2, &recording_flags);
+    log_info("Recording flags = 0x%08x", recording_flags);
+    return success;
+}
+
+//! Initialises the model by reading in the regions and checking recording
+//! data.
+//! \param[in] *timer_period a pointer for the memory address where the timer
+//!            period should be stored during the function.
+//! \return boolean of True if it successfully read all the regions and set up
+//!         all its internal data structures. Otherwise returns False
+static bool initialize(uint32_t *timer_period) {
+    log_info("Initialise: started");
+
+    // Get the address this core's DTCM data starts at from SRAM
+    address_t address = data_specification_get_data_address();
+
+    // Read the header
+    if (!data_specification_read_header(address)) {
+        return false;
+    }
+
+    // Get the timing details
+    address_t system_region = data_specification_get_region(
+            SYSTEM, address);
+    if (!simulation_read_timing_details(
+            system_region, APPLICATION_NAME_HASH, timer_period)) {
+        return false;
+    }
+
+    // setup recording region
+    if (!initialise_recording()){
+        return false;
+    }
+
+    // Setup regions that specify spike source array data
+    if (!read_spike_source_array_parameters(
+            data_specification_get_region(
+                SPIKE_SOURCE_ARRAY_PARAMS, address),
+            data_specification_get_region(SPIKE_DATA_REGION, address))) {
+        return false;
+    }
+
+    log_info("Initialise: completed successfully");
+
+    return true;
+}
+
+void resume_callback() {
+
+    // handle resetting the recording state
+    // Get the recording information
+    address_t address = data_specification_get_data_address();
+    address_t system_region = data_specification_get_region(
+        SYSTEM, address);
+    uint8_t regions_to_record[] = {
+        BUFFERING_OUT_SPIKE_RECORDING_REGION,
+    };
+    uint8_t n_regions_to_record = NUMBER_OF_REGIONS_TO_RECORD;
+    uint32_t *recording_flags_from_system_conf =
+        &system_region[SIMULATION_N_TIMING_DETAIL_WORDS];
+    uint8_t state_region = BUFFERING_OUT_CONTROL_REGION;
+
+    recording_initialize(
+        n_regions_to_record, regions_to_record,
+        recording_flags_from_system_conf, state_region, 2,
+        &recording_flags);
+}
+
+//! \brief Sends the spikes of the blocks of the stream for the current time
+//!        step, and records them if required
+static inline void _do_timestep_update() {
+    while (next_spike_tick <= time) {
+
+        // Read the block, sending a spike for each index in it
+        uint32_t n_spikes = _read_stream_value();
+        uint32_t neuron_id = 0;
+        for (; n_spikes > 0; n_spikes--) {
+            neuron_id += _read_stream_value();
+
+            // Write spike to out spikes
+            out_spikes_set_spike(neuron_id);
+
+            // if no key has been given, do not send spike to fabric.
+            if (has_been_given_key) {
+                log_debug("Sending spike packet %x at %d\n",
+                          key | neuron_id, time);
+                while (!spin1_send_mc_packet(
+                        key | neuron_id, 0, NO_PAYLOAD)) {
+                    spin1_delay_us(1);
+                }
+            }
+        }
+
+        _read_next_spike_tick();
+    }
+
+    // Record output spikes if required
+    if (recording_flags > 0) {
+        out_spikes_record(0, time);
+    }
+    out_spikes_reset();
+
+    if (recording_flags > 0) {
+        recording_do_timestep_update(time);
+    }
+}
+
+//! \brief Timer interrupt callback
+//! \param[in] timer_count the number of times this call back has been
+//!            executed since start of simulation
+//! \param[in] unused for consistency sake of the API always returning two
+//!            parameters, this parameter has no semantics currently and thus
+//!            is set to 0
+//! \return None
+void timer_callback(uint timer_count, uint unused) {
+    use(timer_count);
+    use(unused);
+
+    time++;
+
+    log_debug("Timer tick %u", time);
+
+    // If a fixed number of simulation ticks are specified and these have
+    // passed
+    if (infinite_run != TRUE && time >= simulation_ticks) {
+
+        // go into pause and resume state to avoid another tick
+        simulation_handle_pause_resume(resume_callback);
+
+        // Finalise any recordings that are in progress, writing back the
+        // final amounts of samples recorded to SDRAM
+        if (recording_flags > 0) {
+            recording_finalise();
+        }
+
+        // Subtract 1 from the time so this tick gets done again on the next
+        // run
+        time -= 1;
+        return;
+    }
+
+    _do_timestep_update();
+}
+
+//! \brief Writes the counts of chunks prefetched and of words read directly
+//!        from SDRAM to the provenance region
+//! \param[in] provenance_region The start of the extra provenance data
+void store_provenance_data(address_t provenance_region) {
+    log_debug("writing other provenance data");
+
+    provenance_region[N_CHUNKS_PREFETCHED] = n_chunks_prefetched;
+    provenance_region[N_DIRECT_STREAM_READS] = n_direct_stream_reads;
+
+    log_debug("finished other provenance data");
+}
+
+//! The entry point for this model
+void c_main(void) {
+
+    // Load DTCM data
+    uint32_t timer_period;
+    if (!initialize(&timer_period)) {
+        log_error("Error in initialisation - exiting!");
+        rt_error(RTE_SWERR);
+    }
+
+    // Start the time at "-1" so that the first tick will be 0
+    time = UINT32_MAX;
+
+    // Initialise out spikes buffer to support number of neurons
+    if (!out_spikes_initialize(num_spike_sources)) {
+         rt_error(RTE_SWERR);
+    }
+
+    // Set timer tick (in microseconds)
+    spin1_set_timer_tick(timer_period);
+
+    // Register callbacks
+    spin1_callback_on(TIMER_TICK, timer_callback, TIMER);
+    spin1_callback_on(DMA_TRANSFER_DONE, dma_complete_callback, SDP_AND_DMA);
+
+    // Set up callback listening to SDP messages
+    simulation_register_simulation_sdp_callback(
+        &simulation_ticks, &infinite_run, SDP_AND_DMA);
+
+    // set up provenance registration
+    simulation_register_provenance_callback(
+        store_provenance_data, PROVENANCE_REGION);
+
+    simulation_run();
+}
@@ -14,7 +14,9 @@
 #include <random.h>
 #include <simulation.h>
 #include <spin1_api.h>
+#include <sark.h>
 #include <string.h>
+#include <bit_field.h>
 
 //! data structure for spikes which have multiple timer tick between firings
 //! this is separated from spikes which fire at least once every timer tick as
@@ -28,6 +30,45 @@ typedef struct slow_spike_source_t {
     REAL time_to_spike_ticks;
 } slow_spike_source_t;
 
+//! an entry in the queue of slow spike sources, giving the time step at which
+//! the source is next due to spike
+typedef struct slow_spike_event_t {
+    uint32_t tick;
+    slow_spike_source_t *source;
+} slow_spike_event_t;
+
+//! the ways of drawing the number of spikes of a fast spike source in a time
+//! step, chosen by the host for each distinct fast rate
+typedef enum fast_rate_method {
+    //! multiply uniform variates until the product is below exp(-lambda);
+    //! exact, but draws about lambda + 1 variates
+    FAST_RATE_MULTIPLY,
+    //! search a table of the cumulative distribution with one uniform
+    //! variate; exact to the 2^-32 resolution of the table
+    FAST_RATE_INVERSE_CDF,
+    //! round a normal variate with mean and variance lambda; the cost does
+    //! not depend on lambda, but the distribution is only approximate
+    FAST_RATE_NORMAL
+} fast_rate_method;
+
+//! how to draw the number of spikes of the fast spike sources with a given
+//! rate; the fast rate region holds the number of rates and the number of
+//! words they take, followed by the rates in order of lambda, each
+//! immediately followed by its table of the cumulative distribution, scaled
+//! to 2^32, if it has one
+typedef struct fast_rate_t {
+    uint32_t method;
+    REAL lambda;
+    REAL sqrt_lambda;
+    uint32_t n_cdf_entries;
+    uint32_t cdf[];
+} fast_rate_t;
+
+//! what each position in the header of the fast rate region represents
+typedef enum fast_rate_region_parameters {
+    N_FAST_RATES, N_FAST_RATE_WORDS, FAST_RATES_START_POSITION
+} fast_rate_region_parameters;
+
 //! data structure for spikes which have at least one spike fired per timer
 //! tick; this is separated from spikes which have multiple timer ticks
 //! between firings as there are separate algorithms for each type.
@@ -35,15 +76,25 @@ typedef struct fast_spike_source_t {
     uint32_t neuron_id;
     uint32_t start_ticks;
     uint32_t end_ticks;
+    REAL lambda;
     UFRACT exp_minus_lambda;
+
+    //! how to draw the number of spikes, found on the core from lambda;
+    //! NULL if the host did not provide the rate
+    const fast_rate_t *rate;
 } fast_spike_source_t;
 
+//! the number of words of each fast spike source in the parameter region,
+//! which are those before the rate
+#define FAST_SPIKE_SOURCE_WORDS 5
+
 //! spike source array region ids in human readable form
 typedef enum region {
     SYSTEM, POISSON_PARAMS,
     BUFFERING_OUT_SPIKE_RECORDING_REGION,
     BUFFERING_OUT_CONTROL_REGION,
-    PROVENANCE_REGION
+    PROVENANCE_REGION, RATE_UPDATE_REGION, RATE_SCHEDULE_REGION,
+    FAST_RATE_REGION
 } region;
 
 #define NUMBER_OF_REGIONS_TO_RECORD 1
@@ -55,13 +106,56 @@ typedef enum callback_priorities{
 //! what each position in the poisson parameter region actually represent in
 //! terms of data (each is a word)
 typedef enum poisson_region_parameters{
-    HAS_KEY, TRANSMISSION_KEY, RANDOM_BACKOFF, PARAMETER_SEED_START_POSITION,
+    HAS_KEY, TRANSMISSION_KEY, SEND_SLOTS_PER_TICK, TIMESTEPS_PER_TICK,
+    PARAMETER_SEED_START_POSITION,
 } poisson_region_parameters;
 
+//! entries in the provenance data region after the common entries
+typedef enum extra_provenance_data_region_entries{
+    N_PACED_SPIKES = 0,
+    N_BLOCKING_SPIKES = 1,
+    N_SEND_DEFERRALS = 2,
+    SEND_WAIT_CYCLES = 3,
+    IDLE_CYCLES_LOW = 4,
+    IDLE_CYCLES_HIGH = 5
+} extra_provenance_data_region_entries;
+
+//! what each position in the rate update region represents; the host writes
+//! the updates and then a new sequence number, and the core applies the
+//! updates at its next timer tick and then copies the sequence number to
+//! acknowledge them
+typedef enum rate_update_region_parameters {
+    RATE_UPDATE_SEQUENCE, RATE_UPDATE_ACKNOWLEDGED, N_RATE_UPDATES,
+    RATE_UPDATES_START_POSITION
+} rate_update_region_parameters;
+
+//! a change of the rate of a range of sources; a slow rate has a non-zero mean
+//! inter-spike interval, a fast rate has a non-zero lambda, and a rate of 0
+//! has neither.  exp(-lambda) is 0 for lambda above about 22, so it cannot
+//! tell fast rates apart.
+typedef struct rate_update_t {
+    uint32_t first_neuron_id;
+    uint32_t n_neurons;
+    REAL mean_isi_ticks;
+    REAL lambda;
+    UFRACT exp_minus_lambda;
+} rate_update_t;
+
+//! a change of the rate of a range of sources scheduled in advance; the rate
+//! schedule region holds the number of these followed by the changes, in
+//! order of the time step at which they take effect
+typedef struct scheduled_rate_update_t {
+    uint32_t tick;
+    rate_update_t update;
+} scheduled_rate_update_t;
+
 // Globals
 //! global variable which contains all the data for neurons which are expected
 //! to exhibit slow spike generation (less than 1 per timer tick)
-//! (separated for efficiently purposes)
+//! (separated for efficiently purposes).  There is an entry for every source,
+//! indexed by neuron id, so that the rate of any source can be changed to a
+//! slow one; the entries of sources with fast rates have a mean inter-spike
+//! interval of 0, and so are never queued
 static slow_spike_source_t *slow_spike_source_array = NULL;
 
 //! global variable which contains all the data for neurons which are expected
@@ -69,12 +163,36 @@ static slow_spike_source_t *slow_spike_source_array = NULL;
 //! (separated for efficiently purposes)
 static fast_spike_source_t *fast_spike_source_array = NULL;
 
-//! counter for how many neurons exhibit slow spike generation
-static uint32_t num_slow_spike_sources = 0;
+//! the distinct fast rates provided by the host, in order of lambda,
+//! and the number of them
+static fast_rate_t **fast_rates = NULL;
+static uint32_t n_fast_rates = 0;
+
+//! the number of sources, and so of entries in the slow spike source array
+//! and of the space for entries in the fast spike source array
+static uint32_t num_spike_sources = 0;
+
+//! binary min-heap of the slow spike sources which are due to spike before
+//! the end of their active window, ordered by the time step of their next
+//! spike, so that each time step only touches the sources which spike in it
+static slow_spike_event_t *slow_spike_queue = NULL;
+
+//! the number of slow spike sources in the queue
+static uint32_t slow_spike_queue_size = 0;
 
 //! counter for how many neurons exhibit fast spike generation
 static uint32_t num_fast_spike_sources = 0;
 
+//! the region through which the host changes the rates of the sources
+static address_t rate_update_region;
+
+//! the sources whose rates are being changed by a set of rate updates
+static bit_field_t updated_sources = NULL;
+
+//! the next of the rate changes scheduled by the host, and the number left
+static scheduled_rate_update_t *next_scheduled_update;
+static uint32_t n_scheduled_updates;
+
 //! a variable that will contain the seed to initiate the poisson generator.
 static mars_kiss64_seed_t spike_source_seed;
 
@@ -85,9 +203,37 @@ static bool has_been_given_key;
 //! A variable that contains the key value that this model should transmit with
 static uint32_t key;
 
-//! An amount of microseconds to back off before starting the timer, in an
-//! attempt to avoid overloading the network
-static uint32_t random_backoff_us;
+//! The number of slots into which each timer tick is divided; the timer runs
+//! once per slot, the spikes are generated in the first slot and an equal
+//! share of those not yet sent is sent in each slot, so that the spikes of
+//! the cores are spread over the tick rather than sent in a burst at its start
+static uint32_t n_send_slots = 1;
+
+//! The slot of the current timer tick which the next timer callback runs
+static uint32_t send_slot = 0;
+
+//! The keys of the spikes generated in the current timer tick, the number the
+//! queue can hold, the position of the next to send and the number queued
+static uint32_t *send_queue = NULL;
+static uint32_t send_queue_size = 0;
+static uint32_t send_queue_start = 0;
+static uint32_t send_queue_end = 0;
+
+//! Counts of the spikes sent from the queue and sent while waiting for space
+//! to send, of the times that a slot found no space to send and stopped early,
+//! and of the cycles spent waiting for space to send, for provenance
+static uint32_t n_paced_spikes = 0;
+static uint32_t n_blocking_spikes = 0;
+static uint32_t n_send_deferrals = 0;
+static uint32_t send_wait_cycles = 0;
+
+//! The cycles left in each slot of the timer ticks run after the timer
+//! callback has finished, which the core no longer spends spinning in a
+//! random back-off and so has free for generating spikes, for provenance
+static uint64_t idle_cycles = 0;
+
+//! The number of simulation time steps to run each timer tick
+static uint32_t timesteps_per_tick = 1;
 
 //! keeps track of which types of recording should be done to this model.
 static uint32_t recording_flags = 0;
@@ -114,20 +260,201 @@ static inline REAL slow_spike_source_get_time_to_spike(
             * mean_inter_spike_interval_in_ticks;
 }
 
+//! \brief moves the event at the given position of the slow spike source
+//!        queue up towards the top until it is no earlier than its parent
+//! \param[in] position the position of the event in the queue
+static inline void _slow_spike_queue_sift_up(uint32_t position) {
+    slow_spike_event_t event = slow_spike_queue[position];
+    while (position > 0) {
+        uint32_t parent = (position - 1) >> 1;
+        if (slow_spike_queue[parent].tick <= event.tick) {
+            break;
+        }
+        slow_spike_queue[position] = slow_spike_queue[parent];
+        position = parent;
+    }
+    slow_spike_queue[position] = event;
+}
+
+//! \brief moves the event at the given position of the slow spike source
+//!        queue down towards the bottom until it is no later than its children
+//! \param[in] position the position of the event in the queue
+static inline void _slow_spike_queue_sift_down(uint32_t position) {
+    slow_spike_event_t event = slow_spike_queue[position];
+    while (true) {
+        uint32_t child = (position << 1) + 1;
+        if (child >= slow_spike_queue_size) {
+            break;
+        }
+        if ((child + 1 < slow_spike_queue_size) &&
+                (slow_spike_queue[child + 1].tick <
+                    slow_spike_queue[child].tick)) {
+            child++;
+        }
+        if (event.tick <= slow_spike_queue[child].tick) {
+            break;
+        }
+        slow_spike_queue[position] = slow_spike_queue[child];
+        position = child;
+    }
+    slow_spike_queue[position] = event;
+}
+
+//! \brief works out the time step at which a slow spike source is next due to
+//!        spike from its time to spike at the given time step, leaving the
+//!        time to spike as it will be at the returned time step
+//! \param[in] slow_spike_source the source to schedule
+//! \param[in] tick the time step at which the time to spike applies
+//! \return the time step of the next spike
+static inline uint32_t _slow_spike_source_schedule(
+        slow_spike_source_t *slow_spike_source, uint32_t tick) {
+    REAL time_to_spike = slow_spike_source->time_to_spike_ticks;
+    uint32_t n_ticks = 0;
+    if (REAL_COMPARE(time_to_spike, >, REAL_CONST(0.0))) {
+        n_ticks = (uint32_t) time_to_spike;
+        if (REAL_COMPARE((REAL) n_ticks, <, time_to_spike)) {
+            n_ticks++;
+        }
+    }
+    slow_spike_source->time_to_spike_ticks = time_to_spike - (REAL) n_ticks;
+    return tick + n_ticks;
+}
+
+//! \brief adds a slow spike source to the queue if it is due to spike before
+//!        the end of its active window
+//! \param[in] slow_spike_source the source to add
+//! \param[in] tick the time step at which the time to spike of the source
+//!            applies
+static inline void _slow_spike_queue_add(
+        slow_spike_source_t *slow_spike_source, uint32_t tick) {
+    if (REAL_COMPARE(slow_spike_source->mean_isi_ticks, ==, REAL_CONST(0.0))) {
+        return;
+    }
+    uint32_t next_tick = _slow_spike_source_schedule(slow_spike_source, tick);
+    if (next_tick < slow_spike_source->end_ticks) {
+        uint32_t position = slow_spike_queue_size++;
+        slow_spike_queue[position].tick = next_tick;
+        slow_spike_queue[position].source = slow_spike_source;
+        _slow_spike_queue_sift_up(position);
+    }
+}
+
+//! \brief finds how to draw the number of spikes of a fast rate
+//! \param[in] lambda the mean number of spikes per time step of the rate
+//! \return the rate provided by the host with the same lambda, or NULL if
+//!         there is none
+static const fast_rate_t *_find_fast_rate(REAL lambda) {
+    uint32_t lo = 0;
+    uint32_t hi = n_fast_rates;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) >> 1;
+        if (REAL_COMPARE(fast_rates[mid]->lambda, <, lambda)) {
+            lo = mid + 1;
+        } else if (REAL_COMPARE(fast_rates[mid]->lambda, >, lambda)) {
+            hi = mid;
+        } else {
+            return fast_rates[mid];
+        }
+    }
+    return NULL;
+}
+
+//! \brief draws a Poisson variate by searching the cumulative distribution
+//!        of the rate for the first entry above a uniform variate; the last
+//!        entry takes the probability of all larger values
+//! \param[in] rate the rate, with its table
+//! \return the number of spikes
+static inline uint32_t _fast_rate_inverse_cdf_variate(
+        const fast_rate_t *rate) {
+    uint32_t u = mars_kiss64_seed(spike_source_seed);
+    uint32_t lo = 0;
+    uint32_t hi = rate->n_cdf_entries - 1;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) >> 1;
+        if (u < rate->cdf[mid]) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+//! \brief draws an approximate Poisson variate by rounding a normal variate
+//!        with the same mean and variance
+//! \param[in] rate the rate
+//! \return the number of spikes
+static inline uint32_t _fast_rate_normal_variate(const fast_rate_t *rate) {
+    REAL spikes = rate->lambda + REAL_CONST(0.5) + rate->sqrt_lambda *
+        gaussian_dist_variate(mars_kiss64_seed, spike_source_seed);
+    if (REAL_COMPARE(spikes, <, REAL_CONST(0.0))) {
+        return 0;
+    }
+    return (uint32_t) spikes;
+}
+
 //! \brief Determines how many spikes to transmit this timer tick.
-//! \param[in] exp_minus_lambda The amount of spikes expected to be produced
-//!            this timer interval (timer tick in real time)
+//! \param[in] fast_spike_source The source, with the amount of spikes
+//!            expected to be produced this timer interval (timer tick in real
+//!            time) and how to draw the number
 //! \return a uint32_t which represents the number of spikes to transmit
 //!         this timer tick
 static inline uint32_t fast_spike_source_get_num_spikes(
-        UFRACT exp_minus_lambda) {
-    if (bitsulr(exp_minus_lambda) == bitsulr(UFRACT_CONST(0.0))) {
+        const fast_spike_source_t *fast_spike_source) {
+    if (REAL_COMPARE(fast_spike_source->lambda, ==, REAL_CONST(0.0))) {
         return 0;
     }
-    else {
-        return poisson_dist_variate_exp_minus_lambda(
-            mars_kiss64_seed, spike_source_seed, exp_minus_lambda);
+    const fast_rate_t *rate = fast_spike_source->rate;
+    if (rate != NULL) {
+        if (rate->method == FAST_RATE_INVERSE_CDF) {
+            return _fast_rate_inverse_cdf_variate(rate);
+        } else if (rate->method == FAST_RATE_NORMAL) {
+            return _fast_rate_normal_variate(rate);
+        }
     }
+    return poisson_dist_variate_exp_minus_lambda(
+        mars_kiss64_seed, spike_source_seed,
+        fast_spike_source->exp_minus_lambda);
+}
+
+//! \brief reads the distinct fast rates of the sources, and their tables,
+//!        into DTCM
+//! \param[in] address the absolute SDRAM address of the fast rate region
+//! \return True if the rates were read successfully, False otherwise
+static bool read_fast_rates(address_t address) {
+    n_fast_rates = address[N_FAST_RATES];
+    uint32_t n_words = address[N_FAST_RATE_WORDS];
+    log_info("\t fast rates = %u in %u words", n_fast_rates, n_words);
+    if (n_fast_rates == 0) {
+        return true;
+    }
+
+    uint32_t *fast_rate_data = (uint32_t *) spin1_malloc(
+        n_words * sizeof(uint32_t));
+    fast_rates = (fast_rate_t **) spin1_malloc(
+        n_fast_rates * sizeof(fast_rate_t *));
+    if (fast_rate_data == NULL || fast_rates == NULL) {
+        log_error("Failed to allocate the fast rates");
+        return false;
+    }
+    memcpy(fast_rate_data, &address[FAST_RATES_START_POSITION],
+           n_words * sizeof(uint32_t));
+
+    // Find where each rate starts
+    fast_rate_t *rate = (fast_rate_t *) fast_rate_data;
+    for (uint32_t r = 0; r < n_fast_rates; r++) {
+        fast_rates[r] = rate;
+        log_debug("\t\tlambda = %k, method %u, %u table entries",
+                  rate->lambda, rate->method,
+                  rate->n_cdf_entries);
+        if (rate->method == FAST_RATE_INVERSE_CDF &&
+                rate->n_cdf_entries == 0) {
+            log_error("Fast rate %u has an empty table", r);
+            return false;
+        }
+        rate = (fast_rate_t *) &rate->cdf[rate->n_cdf_entries];
+    }
+    return true;
 }
 
 //! \entry method for reading the parameters stored in Poisson parameter region
@@ -141,8 +468,14 @@ bool read_poisson_parameters(address_t address) {
 
     has_been_given_key = address[HAS_KEY];
     key = address[TRANSMISSION_KEY];
-    random_backoff_us = address[RANDOM_BACKOFF];
-    log_info("\t key = %08x, back off = %u", key, random_backoff_us);
+    n_send_slots = address[SEND_SLOTS_PER_TICK];
+    timesteps_per_tick = address[TIMESTEPS_PER_TICK];
+    log_info("\t key = %08x, send slots = %u, time steps per tick = %u",
+             key, n_send_slots, timesteps_per_tick);
+    if (n_send_slots == 0) {
+        log_error("There must be at least one send slot per tick");
+        return false;
+    }
 
     uint32_t seed_size = sizeof(mars_kiss64_seed_t) / sizeof(uint32_t);
     memcpy(spike_source_seed, &address[PARAMETER_SEED_START_POSITION],
@@ -152,57 +485,120 @@ bool read_poisson_parameters(address_t address) {
     log_info("\tSeed (%u) = %u %u %u %u", seed_size, spike_source_seed[0],
              spike_source_seed[1], spike_source_seed[2], spike_source_seed[3]);
 
-    num_slow_spike_sources = address[PARAMETER_SEED_START_POSITION + seed_size];
+    uint32_t num_slow_spike_sources =
+        address[PARAMETER_SEED_START_POSITION + seed_size];
     num_fast_spike_sources = address[PARAMETER_SEED_START_POSITION +
                                      seed_size + 1];
+    num_spike_sources = num_slow_spike_sources + num_fast_spike_sources;
     log_info("\t slow spike sources = %u, fast spike sources = %u,",
              num_slow_spike_sources, num_fast_spike_sources);
+    if (num_spike_sources == 0) {
+        log_info("read_parameters: completed successfully");
+        return true;
+    }
 
-    // Allocate DTCM for array of slow spike sources and copy block of data
-    if (num_slow_spike_sources > 0) {
-        slow_spike_source_array = (slow_spike_source_t*) spin1_malloc(
-            num_slow_spike_sources * sizeof(slow_spike_source_t));
-        if (slow_spike_source_array == NULL) {
-            log_error("Failed to allocate slow_spike_source_array");
+    // Allocate DTCM for the arrays of spike sources and the queue; each of
+    // these can hold every source, as the rates of the sources can change
+    slow_spike_source_array = (slow_spike_source_t*) spin1_malloc(
+        num_spike_sources * sizeof(slow_spike_source_t));
+    if (slow_spike_source_array == NULL) {
+        log_error("Failed to allocate slow_spike_source_array");
+        return false;
+    }
+    fast_spike_source_array = (fast_spike_source_t*) spin1_malloc(
+        num_spike_sources * sizeof(fast_spike_source_t));
+    if (fast_spike_source_array == NULL) {
+        log_error("Failed to allocate fast_spike_source_array");
+        return false;
+    }
+    slow_spike_queue = (slow_spike_event_t*) spin1_malloc(
+        num_spike_sources * sizeof(slow_spike_event_t));
+    if (slow_spike_queue == NULL) {
+        log_error("Failed to allocate slow_spike_queue");
+        return false;
+    }
+
+    // Copy each slow spike source into the entry for its neuron id
+    uint32_t slow_spikes_offset = PARAMETER_SEED_START_POSITION +
+                                seed_size + 2;
+    slow_spike_source_t *slow_spike_sources =
+        (slow_spike_source_t *) &address[slow_spikes_offset];
+    for (index_t s = 0; s < num_slow_spike_sources; s++) {
+        uint32_t neuron_id = slow_spike_sources[s].neuron_id;
+        if (neuron_id >= num_spike_sources) {
+            log_error("Slow spike source %u has invalid neuron id %u",
+                      s, neuron_id);
             return false;
         }
-        uint32_t slow_spikes_offset = PARAMETER_SEED_START_POSITION +
-                                    seed_size + 2;
-        memcpy(slow_spike_source_array,
-                &address[slow_spikes_offset],
-               num_slow_spike_sources * sizeof(slow_spike_source_t));
-
-        // Loop through slow spike sources and initialise 1st time to spike
-        for (index_t s = 0; s < num_slow_spike_sources; s++) {
-            slow_spike_source_array[s].time_to_spike_ticks =
-                slow_spike_source_get_time_to_spike(
-                    slow_spike_source_array[s].mean_isi_ticks);
-        }
+        slow_spike_source_array[neuron_id] = slow_spike_sources[s];
     }
 
-    // Allocate DTCM for array of fast spike sources and copy block of data
-    if (num_fast_spike_sources > 0) {
-        fast_spike_source_array = (fast_spike_source_t*) spin1_malloc(
-            num_fast_spike_sources * sizeof(fast_spike_source_t));
-        if (fast_spike_source_array == NULL) {
-            log_error("Failed to allocate fast_spike_source_array");
+    // locate offset for the fast spike sources in the SDRAM from where the
+    // seed finished.
+    uint32_t fast_spike_source_offset = slow_spikes_offset
+        + (num_slow_spike_sources * (sizeof(slow_spike_source_t)
+            / sizeof(uint32_t)));
+    for (index_t f = 0; f < num_fast_spike_sources; f++) {
+        memcpy(&fast_spike_source_array[f],
+               &address[fast_spike_source_offset +
+                        (f * FAST_SPIKE_SOURCE_WORDS)],
+               FAST_SPIKE_SOURCE_WORDS * sizeof(uint32_t));
+        fast_spike_source_array[f].rate = _find_fast_rate(
+            fast_spike_source_array[f].lambda);
+    }
+
+    // Give each fast spike source an entry in the slow spike sources, with
+    // no rate
+    for (index_t f = 0; f < num_fast_spike_sources; f++) {
+        fast_spike_source_t *fast_spike_source = &fast_spike_source_array[f];
+        if (fast_spike_source->neuron_id >= num_spike_sources) {
+            log_error("Fast spike source %u has invalid neuron id %u",
+                      f, fast_spike_source->neuron_id);
             return false;
         }
-        // locate offset for the fast spike sources in the SDRAM from where the
-        // seed finished.
-        uint32_t fast_spike_source_offset =
-                PARAMETER_SEED_START_POSITION + seed_size + 2 +
-            + (num_slow_spike_sources * (sizeof(slow_spike_source_t)
-                / sizeof(uint32_t)));
-        memcpy(fast_spike_source_array, &address[fast_spike_source_offset],
-               num_fast_spike_sources * sizeof(fast_spike_source_t));
-
-        for (index_t s = 0; s < num_fast_spike_sources; s++) {
-            log_debug("\t\tNeuron id %d, exp(-k) = %0.8x",
-                      fast_spike_source_array[s].neuron_id,
-                      fast_spike_source_array[s].exp_minus_lambda);
+        slow_spike_source_t *slow_spike_source =
+            &slow_spike_source_array[fast_spike_source->neuron_id];
+        slow_spike_source->neuron_id = fast_spike_source->neuron_id;
+        slow_spike_source->start_ticks = fast_spike_source->start_ticks;
+        slow_spike_source->end_ticks = fast_spike_source->end_ticks;
+        slow_spike_source->mean_isi_ticks = REAL_CONST(0.0);
+        slow_spike_source->time_to_spike_ticks = REAL_CONST(0.0);
+        log_debug("\t\tNeuron id %d, lambda = %k",
+                  fast_spike_source->neuron_id, fast_spike_source->lambda);
+    }
+
+    // Loop through slow spike sources, initialise 1st time to spike from
+    // the start of the source, and queue them
+    slow_spike_queue_size = 0;
+    for (index_t s = 0; s < num_spike_sources; s++) {
+        slow_spike_source_t *slow_spike_source = &slow_spike_source_array[s];
+        if (REAL_COMPARE(slow_spike_source->mean_isi_ticks, !=,
+                REAL_CONST(0.0))) {
+            slow_spike_source->time_to_spike_ticks =
+                slow_spike_source_get_time_to_spike(
+                    slow_spike_source->mean_isi_ticks);
+            _slow_spike_queue_add(
+                slow_spike_source, slow_spike_source->start_ticks);
         }
     }
+
+    // Allocate the queue of spikes to send, with room for two spikes per
+    // source per time step; any more are sent immediately
+    send_queue_size = 2 * num_spike_sources * timesteps_per_tick;
+    send_queue = (uint32_t *) spin1_malloc(send_queue_size * sizeof(uint32_t));
+    if (send_queue == NULL) {
+        log_error("Failed to allocate send_queue");
+        return false;
+    }
+
+    // Allocate a bit field to mark the sources being updated
+    updated_sources = (bit_field_t) spin1_malloc(
+        get_bit_field_size(num_spike_sources) * sizeof(uint32_t));
+    if (updated_sources == NULL) {
+        log_error("Failed to allocate updated_sources");
+        return false;
+    }
+    clear_bit_field(updated_sources, get_bit_field_size(num_spike_sources));
     log_info("read_parameters: completed successfully");
     return true;
 }
@@ -264,17 +660,143 @@ static bool initialize(uint32_t *timer_period) {
         return false;
     }
 
+    // Read the fast rates before the sources which use them
+    if (!read_fast_rates(
+            data_specification_get_region(FAST_RATE_REGION, address))) {
+        return false;
+    }
+
     // Setup regions that specify spike source array data
     if (!read_poisson_parameters(
             data_specification_get_region(POISSON_PARAMS, address))) {
         return false;
     }
+    rate_update_region = data_specification_get_region(
+        RATE_UPDATE_REGION, address);
+
+    // Find the rate changes scheduled in advance
+    address_t rate_schedule_region = data_specification_get_region(
+        RATE_SCHEDULE_REGION, address);
+    n_scheduled_updates = rate_schedule_region[0];
+    next_scheduled_update =
+        (scheduled_rate_update_t *) &rate_schedule_region[1];
+    log_info("\t %u scheduled rate changes", n_scheduled_updates);
 
     log_info("Initialise: completed successfully");
 
     return true;
 }
 
+//! \brief marks the sources covered by a rate update as being updated
+//! \param[in] update the rate update
+static inline void _mark_rate_update(rate_update_t *update) {
+    uint32_t end_id = update->first_neuron_id + update->n_neurons;
+    if (end_id > num_spike_sources) {
+        end_id = num_spike_sources;
+    }
+    for (uint32_t n = update->first_neuron_id; n < end_id; n++) {
+        bit_field_set(updated_sources, n);
+    }
+}
+
+//! \brief takes the sources marked as being updated out of the queue and the
+//!        fast spike sources; this costs a pass over each, however many
+//!        sources are updated
+static void _remove_marked_sources() {
+
+    // Remove the updated sources from the queue, and restore the heap order
+    // of the rest
+    uint32_t n_kept = 0;
+    for (uint32_t i = 0; i < slow_spike_queue_size; i++) {
+        if (!bit_field_test(updated_sources,
+                slow_spike_queue[i].source->neuron_id)) {
+            slow_spike_queue[n_kept++] = slow_spike_queue[i];
+        }
+    }
+    slow_spike_queue_size = n_kept;
+    for (uint32_t i = n_kept >> 1; i > 0; i--) {
+        _slow_spike_queue_sift_down(i - 1);
+    }
+
+    // Remove the updated sources from the fast spike sources
+    uint32_t f = 0;
+    while (f < num_fast_spike_sources) {
+        if (bit_field_test(updated_sources,
+                fast_spike_source_array[f].neuron_id)) {
+            fast_spike_source_array[f] =
+                fast_spike_source_array[--num_fast_spike_sources];
+        } else {
+            f++;
+        }
+    }
+}
+
+//! \brief puts each marked source covered by a rate update back in as a slow
+//!        or fast source with its new rate, and unmarks it; the time to the
+//!        next spike of each slow source is drawn afresh.  Sources which are
+//!        no longer marked have already been given a later update.
+//! \param[in] update the rate update
+//! \param[in] first_time the first time step at which the new rate applies
+static inline void _apply_rate_update(
+        rate_update_t *update, uint32_t first_time) {
+    uint32_t end_id = update->first_neuron_id + update->n_neurons;
+    if (end_id > num_spike_sources) {
+        end_id = num_spike_sources;
+    }
+    for (uint32_t n = update->first_neuron_id; n < end_id; n++) {
+        if (!bit_field_test(updated_sources, n)) {
+            continue;
+        }
+        bit_field_clear(updated_sources, n);
+
+        slow_spike_source_t *slow_spike_source = &slow_spike_source_array[n];
+        slow_spike_source->mean_isi_ticks = update->mean_isi_ticks;
+        if (REAL_COMPARE(update->mean_isi_ticks, !=, REAL_CONST(0.0))) {
+            slow_spike_source->time_to_spike_ticks =
+                slow_spike_source_get_time_to_spike(
+                    slow_spike_source->mean_isi_ticks);
+            uint32_t start_time = slow_spike_source->start_ticks;
+            if (start_time < first_time) {
+                start_time = first_time;
+            }
+            _slow_spike_queue_add(slow_spike_source, start_time);
+        } else if (REAL_COMPARE(update->lambda, !=, REAL_CONST(0.0))) {
+            fast_spike_source_t *fast_spike_source =
+                &fast_spike_source_array[num_fast_spike_sources++];
+            fast_spike_source->neuron_id = n;
+            fast_spike_source->start_ticks = slow_spike_source->start_ticks;
+            fast_spike_source->end_ticks = slow_spike_source->end_ticks;
+            fast_spike_source->lambda = update->lambda;
+            fast_spike_source->exp_minus_lambda = update->exp_minus_lambda;
+            fast_spike_source->rate = _find_fast_rate(update->lambda);
+        }
+    }
+}
+
+//! \brief applies any rate updates written by the host since the last ones,
+//!        from the next time step; where updates overlap, the last wins
+static void _apply_host_rate_updates() {
+    uint32_t sequence = rate_update_region[RATE_UPDATE_SEQUENCE];
+    if (sequence == rate_update_region[RATE_UPDATE_ACKNOWLEDGED]) {
+        return;
+    }
+    uint32_t n_updates = rate_update_region[N_RATE_UPDATES];
+    rate_update_t *updates =
+        (rate_update_t *) &rate_update_region[RATE_UPDATES_START_POSITION];
+    log_debug("Applying %u rate updates at %u", n_updates, time);
+
+    for (uint32_t u = 0; u < n_updates; u++) {
+        _mark_rate_update(&updates[u]);
+    }
+    _remove_marked_sources();
+    for (uint32_t u = n_updates; u > 0; u--) {
+        _apply_rate_update(&updates[u - 1], time + 1);
+    }
+
+    // Tell the host that the updates have been applied
+    rate_update_region[RATE_UPDATE_ACKNOWLEDGED] = sequence;
+}
+
 void resume_callback() {
 
     // handle resetting the recording state
@@ -294,83 +816,144 @@ void resume_callback() {
         n_regions_to_record, regions_to_record,
         recording_flags_from_system_conf, state_region, 2,
         &recording_flags);
-}
-
-//! \brief Timer interrupt callback
-//! \param[in] timer_count the number of times this call back has been
-//!            executed since start of simulation
-//! \param[in] unused for consistency sake of the API always returning two
-//!            parameters, this parameter has no semantics currently and thus
-//!            is set to 0
-//! \return None
-void timer_callback(uint timer_count, uint unused) {
-    use(timer_count);
-    use(unused);
-    time++;
 
-    log_debug("Timer tick %u", time);
+    // Apply any rates changed by the host while paused, so that they are
+    // acknowledged before the first time step of the run
+    _apply_host_rate_updates();
+}
 
-    // If a fixed number of simulation ticks are specified and these have passed
-    if (infinite_run != TRUE && time >= simulation_ticks) {
+//! \brief applies the scheduled rate changes which take effect at the
+//!        current time step; the changes are read from SDRAM only as they
+//!        become due
+static inline void _apply_scheduled_rate_updates() {
+    if ((n_scheduled_updates == 0) || (next_scheduled_update->tick > time)) {
+        return;
+    }
 
-        // go into pause and resume state to avoid another tick
-        simulation_handle_pause_resume(resume_callback);
+    // Find the changes due now
+    uint32_t n_due = 0;
+    while ((n_due < n_scheduled_updates) &&
+            (next_scheduled_update[n_due].tick <= time)) {
+        _mark_rate_update(&next_scheduled_update[n_due].update);
+        n_due++;
+    }
+    log_debug("Applying %u scheduled rate changes at %u", n_due, time);
 
-        // Finalise any recordings that are in progress, writing back the final
-        // amounts of samples recorded to SDRAM
-        if (recording_flags > 0) {
-            recording_finalise();
-        }
+    _remove_marked_sources();
+    for (uint32_t u = n_due; u > 0; u--) {
+        _apply_rate_update(&next_scheduled_update[u - 1].update, time);
+    }
+    next_scheduled_update += n_due;
+    n_scheduled_updates -= n_due;
+}
 
-        // Subtract 1 from the time so this tick gets done again on the next
-        // run
-        time -= 1;
+//! \brief sends a spike, waiting for space to send it if needed
+//! \param[in] spike_key the key of the spike
+static void _send_spike_blocking(uint32_t spike_key) {
+    if (spin1_send_mc_packet(spike_key, 0, NO_PAYLOAD)) {
         return;
     }
+    n_blocking_spikes++;
+
+    // Measure the wait with the timer, which counts down from its period
+    uint32_t start_count = tc[T1_COUNT];
+    do {
+        spin1_delay_us(1);
+    } while (!spin1_send_mc_packet(spike_key, 0, NO_PAYLOAD));
+    uint32_t end_count = tc[T1_COUNT];
+    if (end_count > start_count) {
+        start_count += tc[T1_LOAD];
+    }
+    send_wait_cycles += start_count - end_count;
+}
 
-    // Sleep for a random time
-    spin1_delay_us(random_backoff_us);
+//! \brief queues a spike to be sent later in the timer tick, or sends it now
+//!        if the queue is full
+//! \param[in] spike_key the key of the spike
+static inline void _queue_spike(uint32_t spike_key) {
+    if (send_queue_end < send_queue_size) {
+        send_queue[send_queue_end++] = spike_key;
+    } else {
+        _send_spike_blocking(spike_key);
+    }
+}
 
-    // Loop through slow spike sources
-    slow_spike_source_t *slow_spike_sources = slow_spike_source_array;
-    for (index_t s = num_slow_spike_sources; s > 0; s--) {
+//! \brief sends an equal share of the queued spikes for each slot left in the
+//!        timer tick, stopping early rather than waiting if there is no space
+//!        to send
+//! \param[in] n_slots_left the number of slots left in the tick, including
+//!            this one
+static void _send_queued_spikes(uint32_t n_slots_left) {
+    uint32_t n_queued = send_queue_end - send_queue_start;
+    uint32_t n_to_send = (n_queued + n_slots_left - 1) / n_slots_left;
+    for (; n_to_send > 0; n_to_send--) {
+        if (!spin1_send_mc_packet(
+                send_queue[send_queue_start], 0, NO_PAYLOAD)) {
+            n_send_deferrals++;
+            return;
+        }
+        send_queue_start++;
+        n_paced_spikes++;
+    }
+}
 
-        // If this spike source is active this tick
-        slow_spike_source_t *slow_spike_source = slow_spike_sources++;
-        if ((time >= slow_spike_source->start_ticks)
-                && (time < slow_spike_source->end_ticks)
-                && (REAL_COMPARE(slow_spike_source->mean_isi_ticks, !=,
-                    REAL_CONST(0.0)))) {
+//! \brief sends any spikes still queued, waiting for space to send them if
+//!        needed, and empties the queue
+static void _flush_send_queue() {
+    for (; send_queue_start < send_queue_end; send_queue_start++) {
+        _send_spike_blocking(send_queue[send_queue_start]);
+    }
+    send_queue_start = 0;
+    send_queue_end = 0;
+}
 
-            // If this spike source should spike now
-            if (REAL_COMPARE(slow_spike_source->time_to_spike_ticks, <=,
-                             REAL_CONST(0.0))) {
+//! \brief sends the share of the queued spikes of a slot of the timer tick;
+//!        the last slot sends all those left, so that the spikes of a tick
+//!        are never delayed into the next tick
+//! \param[in] slot the slot of the timer tick
+static inline void _send_slot_share(uint32_t slot) {
+    _send_queued_spikes(n_send_slots - slot);
+    if (slot + 1 == n_send_slots) {
+        _flush_send_queue();
+    }
+}
 
-                // Write spike to out spikes
-                out_spikes_set_spike(slow_spike_source->neuron_id);
+//! \brief Generates the spikes of all the sources for the current time step
+//!        and queues them to be sent, and records them if required
+static inline void _do_timestep_update() {
 
-                // if no key has been given, do not send spike to fabric.
-                if (has_been_given_key) {
+    // Switch the rates of any sources scheduled to change now
+    _apply_scheduled_rate_updates();
 
-                    // Send package
-                    while (!spin1_send_mc_packet(
-                            key | slow_spike_source->neuron_id, 0,
-                            NO_PAYLOAD)) {
-                        spin1_delay_us(1);
-                    }
-                    log_debug("Sending spike packet %x at %d\n",
-                        key | slow_spike_source->neuron_id, time);
-                }
+    // Send a spike from each slow spike source due to spike now
+    while ((slow_spike_queue_size > 0) &&
+            (slow_spike_queue[0].tick <= time)) {
+        slow_spike_source_t *slow_spike_source = slow_spike_queue[0].source;
 
-                // Update time to spike
-                slow_spike_source->time_to_spike_ticks +=
-                    slow_spike_source_get_time_to_spike(
-                        slow_spike_source->mean_isi_ticks);
-            }
+        // Write spike to out spikes
+        out_spikes_set_spike(slow_spike_source->neuron_id);
+
+        // if no key has been given, do not send spike to fabric.
+        if (has_been_given_key) {
+            log_debug("Queueing spike packet %x at %d\n",
+                key | slow_spike_source->neuron_id, time);
+            _queue_spike(key | slow_spike_source->neuron_id);
+        }
 
-            // Subtract tick
-            slow_spike_source->time_to_spike_ticks -= REAL_CONST(1.0);
+        // Update time to spike, which counts from the next time step as at
+        // most one spike is sent per time step, and either move the source
+        // to its new place in the queue or, if it is done, remove it
+        slow_spike_source->time_to_spike_ticks +=
+            slow_spike_source_get_time_to_spike(
+                slow_spike_source->mean_isi_ticks) - REAL_CONST(1.0);
+        uint32_t next_tick = _slow_spike_source_schedule(
+            slow_spike_source, time + 1);
+        if (next_tick < slow_spike_source->end_ticks) {
+            slow_spike_queue[0].tick = next_tick;
+        } else {
+            slow_spike_queue[0] = slow_spike_queue[--slow_spike_queue_size];
         }
+        _slow_spike_queue_sift_down(0);
     }
 
     // Loop through fast spike sources
@@ -383,7 +966,7 @@ void timer_callback(uint timer_count, uint unused) {
 
             // Get number of spikes to send this tick
             uint32_t num_spikes = fast_spike_source_get_num_spikes(
-                fast_spike_source->exp_minus_lambda);
+                fast_spike_source);
             log_debug("Generating %d spikes", num_spikes);
 
             // If there are any
@@ -398,12 +981,9 @@ void timer_callback(uint timer_count, uint unused) {
 
                     // if no key has been given, do not send spike to fabric.
                     if (has_been_given_key){
-                        log_debug("Sending spike packet %x at %d\n",
+                        log_debug("Queueing spike packet %x at %d\n",
                                   spike_key, time);
-                        while (!spin1_send_mc_packet(spike_key, 0,
-                                                     NO_PAYLOAD)) {
-                            spin1_delay_us(1);
-                        }
+                        _queue_spike(spike_key);
                     }
                 }
             }
@@ -421,6 +1001,95 @@ void timer_callback(uint timer_count, uint unused) {
     }
 }
 
+//! \brief adds the cycles left until the next timer callback to the idle
+//!        cycles; none are left if the callback is already due
+static inline void _count_idle_cycles() {
+
+    // The timer counts down to the next callback, and its interrupt is
+    // pending if the count has already been reloaded
+    if (tc[T1_MASK_INT] == 0) {
+        idle_cycles += tc[T1_COUNT];
+    }
+}
+
+//! \brief Timer interrupt callback; runs once per send slot, running
+//!        timesteps_per_tick time steps in the first slot of each timer tick
+//!        and sending a share of their spikes in each slot
+//! \param[in] timer_count the number of times this call back has been
+//!            executed since start of simulation
+//! \param[in] unused for consistency sake of the API always returning two
+//!            parameters, this parameter has no semantics currently and thus
+//!            is set to 0
+//! \return None
+void timer_callback(uint timer_count, uint unused) {
+    use(timer_count);
+    use(unused);
+
+    // Send the next share of the spikes in all but the first slot of a tick
+    uint32_t slot = send_slot;
+    send_slot = (slot + 1 < n_send_slots) ? slot + 1 : 0;
+    if (slot > 0) {
+        _send_slot_share(slot);
+        _count_idle_cycles();
+        return;
+    }
+
+    // Pick up any new rates from the host
+    _apply_host_rate_updates();
+
+    for (uint32_t step = 0; step < timesteps_per_tick; step++) {
+        time++;
+
+        log_debug("Timer tick %u", time);
+
+        // If a fixed number of simulation ticks are specified and these have
+        // passed
+        if (infinite_run != TRUE && time >= simulation_ticks) {
+
+            // Send the spikes of the time steps already run, and start the
+            // next run at the start of a tick
+            _flush_send_queue();
+            send_slot = 0;
+
+            // go into pause and resume state to avoid another tick
+            simulation_handle_pause_resume(resume_callback);
+
+            // Finalise any recordings that are in progress, writing back the
+            // final amounts of samples recorded to SDRAM
+            if (recording_flags > 0) {
+                recording_finalise();
+            }
+
+            // Subtract 1 from the time so this tick gets done again on the
+            // next run
+            time -= 1;
+            return;
+        }
+
+        _do_timestep_update();
+    }
+
+    // Send the first share of the spikes
+    _send_slot_share(0);
+    _count_idle_cycles();
+}
+
+//! \brief Writes the counts of paced and blocking sends, and the cycles
+//!        waited and left idle, to the provenance region
+//! \param[in] provenance_region The start of the extra provenance data
+void store_provenance_data(address_t provenance_region) {
+    log_debug("writing other provenance data");
+
+    provenance_region[N_PACED_SPIKES] = n_paced_spikes;
+    provenance_region[N_BLOCKING_SPIKES] = n_blocking_spikes;
+    provenance_region[N_SEND_DEFERRALS] = n_send_deferrals;
+    provenance_region[SEND_WAIT_CYCLES] = send_wait_cycles;
+    provenance_region[IDLE_CYCLES_LOW] = (uint32_t) idle_cycles;
+    provenance_region[IDLE_CYCLES_HIGH] = (uint32_t) (idle_cycles >> 32);
+
+    log_debug("finished other provenance data");
+}
+
 //! The entry point for this model
 void c_main(void) {
 
@@ -435,13 +1104,13 @@ void c_main(void) {
     time = UINT32_MAX;
 
     // Initialise out spikes buffer to support number of neurons
-    if (!out_spikes_initialize(num_fast_spike_sources
-                               + num_slow_spike_sources)) {
+    if (!out_spikes_initialize(num_spike_sources)) {
          rt_error(RTE_SWERR);
     }
 
-    // Set timer tick (in microseconds)
-    spin1_set_timer_tick(timer_period);
+    // Set timer tick (in microseconds) to run once per send slot; the host
+    // makes sure that the slots divide the period exactly
+    spin1_set_timer_tick(timer_period / n_send_slots);
 
     // Register callback
     spin1_callback_on(TIMER_TICK, timer_callback, TIMER);
@@ -451,7 +1120,8 @@ void c_main(void) {
         &simulation_ticks, &infinite_run, SDP);
 
     // set up provenance registration
-    simulation_register_provenance_callback(NULL, PROVENANCE_REGION);
+    simulation_register_provenance_callback(
+        store_provenance_data, PROVENANCE_REGION);
 
     simulation_run();
 }
@@ -52,6 +52,8 @@ from spynnaker.pyNN.models.spike_source.spike_source_poisson\
     import SpikeSourcePoisson
 from spynnaker.pyNN.models.spike_source.spike_source_array \
     import SpikeSourceArray
+from spynnaker.pyNN.models.spike_source.spike_source_array_on_chip \
+    import SpikeSourceArrayOnChip
 from spynnaker.pyNN.models.spike_source.spike_source_from_file \
     import SpikeSourceFromFile
 
@@ -0,0 +1,84 @@
+from spinn_front_end_common.utilities.utility_objs\
+    .provenance_data_item import ProvenanceDataItem
+
+from spynnaker.pyNN.utilities import constants
+
+
+class ProvidesProfilerProvenanceImpl(object):
+    """ Reads the phase profile that binaries built with\
+        PROFILER=PROFILER_ENABLED write after their other provenance data\
+        (see neural_modelling/src/common/profiler.h); to be mixed in with\
+        ProvidesProvenanceDataFromMachineImpl
+    """
+
+    def _get_profiler_provenance_items(
+            self, profiler_data, label, x, y, p, names):
+        """ Convert the phase profile of a core built with\
+            PROFILER=PROFILER_ENABLED into a table of provenance items
+
+        :param profiler_data: The profiler words of the provenance data
+        :return: A list of provenance items, empty if not profiled
+        """
+        n_phases = profiler_data[0]
+        if n_phases == 0:
+            return []
+        if n_phases != len(constants.PROFILER_PHASES):
+            return [ProvenanceDataItem(
+                self._add_name(names, "Profile_phases"), n_phases,
+                report=True,
+                message=(
+                    "The profile of {} on {}, {}, {} has {} phases rather "
+                    "than the {} expected, so the binary does not match "
+                    "this version of sPyNNaker and the profile has not "
+                    "been read.".format(
+                        label, x, y, p, n_phases,
+                        len(constants.PROFILER_PHASES))))]
+        timer_period_cycles = float(profiler_data[1])
+
+        provenance_items = list()
+        for phase in range(n_phases):
+            start = 2 + (phase * constants.PROFILER_WORDS_PER_PHASE)
+            (n_samples, min_cycles, max_cycles, total_lo, total_hi) = \
+                profiler_data[start:start + 5]
+
+            # Leave out the phases that the binary does not have
+            if n_samples == 0:
+                continue
+            bins = profiler_data[
+                start + 5:start + constants.PROFILER_WORDS_PER_PHASE]
+            total_cycles = (int(total_hi) << 32) | int(total_lo)
+            mean_cycles = 0
+            if n_samples > 0:
+                mean_cycles = total_cycles / n_samples
+            max_utilisation = max_cycles / timer_period_cycles
+
+            phase_names = list(names)
+            phase_names.append("Profile")
+            phase_names.append(constants.PROFILER_PHASES[phase])
+            provenance_items.append(ProvenanceDataItem(
+                self._add_name(phase_names, "Samples"), n_samples))
+            provenance_items.append(ProvenanceDataItem(
+                self._add_name(phase_names, "Min_cycles"), min_cycles))
+            provenance_items.append(ProvenanceDataItem(
+                self._add_name(phase_names, "Mean_cycles"), mean_cycles))
+            provenance_items.append(ProvenanceDataItem(
+                self._add_name(phase_names, "Max_cycles"), max_cycles))
+            provenance_items.append(ProvenanceDataItem(
+                self._add_name(phase_names, "Mean_utilisation_percent"),
+                100.0 * mean_cycles / timer_period_cycles))
+            provenance_items.append(ProvenanceDataItem(
+                self._add_name(phase_names, "Max_utilisation_percent"),
+                100.0 * max_utilisation,
+                report=(max_utilisation >
+                        constants.PROFILER_UTILISATION_WARNING),
+                message=(
+                    "The {} phase of {} on {}, {}, {} took up to {:.1f}% of "
+                    "the timer tic, so the core is close to overrunning. "
+                    "Please increase the time_scale_factor or decrease the "
+                    "number of neurons per core.".format(
+                        constants.PROFILER_PHASES[phase], label, x, y, p,
+                        100.0 * max_utilisation))))
+            provenance_items.append(ProvenanceDataItem(
+                self._add_name(phase_names, "Histogram"),
+                " ".join(str(count) for count in bins)))
+        return provenance_items
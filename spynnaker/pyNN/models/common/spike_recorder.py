@@ -8,6 +8,68 @@ import logging
 
 logger = logging.getLogger(__name__)
 
+# The top bit of a record header indicates a list of indices; the rest of the
+# header is the number of indices or the number of words in the bit field
+_SPARSE_RECORD_FLAG = 0x80000000
+_RECORD_COUNT_MASK = 0x7FFFFFFF
+
+# The time and header words at the start of each record
+_N_RECORD_HEADER_WORDS = 2
+
+
+def decode_spike_records(raw_data, n_words):
+    """ Decode spike records, each of which is either a bit field or a list\
+        of 16-bit neuron indices
+
+    :param raw_data: The recorded bytes
+    :param n_words: The number of words in a bit field record
+    :return: A tuple of the time step and the neuron index of each spike
+    :rtype: (numpy.ndarray, numpy.ndarray)
+    """
+    words = numpy.asarray(raw_data, dtype="uint8").view(dtype="<u4")
+
+    # Find the start of each record; this is the only sequential step, as
+    # each record length depends on the header before it
+    starts = list()
+    position = 0
+    n_total_words = len(words)
+    while position < n_total_words:
+        starts.append(position)
+        header = int(words[position + 1])
+        count = header & _RECORD_COUNT_MASK
+        if header & _SPARSE_RECORD_FLAG:
+            count = (count + 1) >> 1
+        position += _N_RECORD_HEADER_WORDS + count
+    starts = numpy.array(starts, dtype="int64")
+    if len(starts) == 0:
+        return (numpy.zeros(0, dtype="uint32"),
+                numpy.zeros(0, dtype="uint32"))
+    times = words[starts]
+    headers = words[starts + 1]
+    sparse = (headers & _SPARSE_RECORD_FLAG) != 0
+
+    # Unpack the bit field records all at once
+    bit_field_starts = starts[~sparse] + _N_RECORD_HEADER_WORDS
+    bit_field_words = words[
+        bit_field_starts[:, None] + numpy.arange(n_words)]
+    spikes = bit_field_words.astype("<u4").byteswap().view("uint8")
+    bits = numpy.fliplr(numpy.unpackbits(spikes).reshape(
+        (-1, 32))).reshape((-1, n_words * 32))
+    bit_field_records, bit_field_indices = numpy.where(bits == 1)
+    bit_field_times = times[~sparse][bit_field_records]
+
+    # Gather the index records as one array of half-words
+    counts = (headers[sparse] & _RECORD_COUNT_MASK).astype("int64")
+    half_word_starts = (starts[sparse] + _N_RECORD_HEADER_WORDS) * 2
+    offsets = numpy.arange(counts.sum()) - numpy.repeat(
+        numpy.cumsum(counts) - counts, counts)
+    sparse_indices = words.view(dtype="<u2")[
+        numpy.repeat(half_word_starts, counts) + offsets]
+    sparse_times = numpy.repeat(times[sparse], counts)
+
+    return (numpy.concatenate((bit_field_times, sparse_times)),
+            numpy.concatenate((bit_field_indices, sparse_indices)))
+
 
 class SpikeRecorder(object):
 
@@ -27,7 +89,8 @@ class SpikeRecorder(object):
         if not self._record:
             return 0
 
-        out_spike_bytes = int(math.ceil(n_neurons / 32.0)) * 4
+        # A bit field plus the record header is the worst case
+        out_spike_bytes = (int(math.ceil(n_neurons / 32.0)) + 1) * 4
         return recording_utils.get_recording_region_size_in_bytes(
             n_machine_time_steps, out_spike_bytes)
 
@@ -67,8 +130,6 @@ class SpikeRecorder(object):
 
             # Read the spikes
             n_words = int(math.ceil(subvertex_slice.n_atoms / 32.0))
-            n_bytes = n_words * 4
-            n_words_with_timestamp = n_words + 1
 
             # for buffering output info is taken form the buffer manager
             neuron_param_region_data_pointer, data_missing = \
@@ -77,16 +138,8 @@ class SpikeRecorder(object):
             if data_missing:
                 missing_str += "({}, {}, {}); ".format(x, y, p)
             record_raw = neuron_param_region_data_pointer.read_all()
-            raw_data = (numpy.asarray(record_raw, dtype="uint8").
-                        view(dtype="<i4")).reshape(
-                [-1, n_words_with_timestamp])
-            split_record = numpy.array_split(raw_data, [1, 1], 1)
-            record_time = split_record[0] * float(ms_per_tick)
-            spikes = split_record[2].byteswap().view("uint8")
-            bits = numpy.fliplr(numpy.unpackbits(spikes).reshape(
-                (-1, 32))).reshape((-1, n_bytes * 8))
-            time_indices, indices = numpy.where(bits == 1)
-            times = record_time[time_indices].reshape((-1))
+            ticks, indices = decode_spike_records(record_raw, n_words)
+            times = ticks * float(ms_per_tick)
             indices = indices + lo_atom
             spike_ids.append(indices)
             spike_times.append(times)
@@ -2,16 +2,58 @@ from spinn_machine.utilities.progress_bar import ProgressBar
 
 from spynnaker.pyNN.models.common import recording_utils
 
+import math
 import numpy
 import logging
 logger = logging.getLogger(__name__)
 
+# The value written to the machine to indicate no compression
+NO_V_COMPRESSION = 0xFFFFFFFF
+
+
+def decode_compressed_v(record_raw, n_atoms, compression_shift):
+    """ Decode voltages recorded as a baseline plus 16-bit differences
+
+    Each record is a time, a baseline voltage in s16.15 and then one unsigned\
+    16-bit difference per neuron (padded to a whole word).  Each difference\
+    is in units of 2^compression_shift of the s16.15 value, so the decoded\
+    voltage is truncated to a resolution of 2^(compression_shift - 15) mV,\
+    and is clipped at 65535 units above the baseline.
+
+    :param record_raw: The recorded bytes
+    :param n_atoms: The number of neurons recorded
+    :param compression_shift: The shift applied to each difference
+    :return: A tuple of the times in ticks and the voltages, with one row\
+        per record
+    :rtype: (numpy.ndarray, numpy.ndarray)
+    """
+    n_delta_words = (n_atoms + 1) // 2
+    record = numpy.asarray(record_raw, dtype="uint8").view(
+        dtype="<i4").reshape((-1, n_delta_words + 2))
+    record_time = record[:, 0:1]
+    baseline = record[:, 1:2].astype("float64")
+    deltas = record[:, 2:].copy().view(dtype="<u2")[:, :n_atoms]
+    scale = float(1 << compression_shift)
+    voltages = (baseline + (deltas * scale)) / 32767.0
+    return record_time, voltages
+
 
 class VRecorder(object):
 
-    def __init__(self, machine_time_step):
+    def __init__(self, machine_time_step, compression_shift=None):
+        """
+
+        :param machine_time_step: The time step of the simulation in\
+            microseconds
+        :param compression_shift: If not None, voltages are recorded as\
+            16-bit differences from the lowest voltage of each time step,\
+            each shifted right by this amount, giving a resolution of\
+            2^(compression_shift - 15) mV over a range of\
+            2^(compression_shift + 1) mV
+        """
         self._record_v = False
         self._machine_time_step = machine_time_step
+        self._compression_shift = compression_shift
 
     @property
     def record_v(self):
@@ -21,16 +63,36 @@ class VRecorder(object):
     def record_v(self, record_v):
         self._record_v = record_v
 
+    @property
+    def compression_shift(self):
+        """ The shift to be written to the machine, or NO_V_COMPRESSION if\
+            the voltages are not compressed or not recorded, so that the\
+            machine only allocates the compressed record when it is used
+        """
+        if self._compression_shift is None or not self._record_v:
+            return NO_V_COMPRESSION
+        return self._compression_shift
+
     def get_sdram_usage_in_bytes(self, n_neurons, n_machine_time_steps):
         if not self._record_v:
             return 0
 
+        bytes_per_timestep = 4 * n_neurons
+        if self._compression_shift is not None:
+
+            # A baseline plus a half-word per neuron, padded to a word
+            bytes_per_timestep = 4 + (4 * int(math.ceil(n_neurons / 2.0)))
         return recording_utils.get_recording_region_size_in_bytes(
-            n_machine_time_steps, 4 * n_neurons)
+            n_machine_time_steps, bytes_per_timestep)
 
-    def get_dtcm_usage_in_bytes(self):
+    def get_dtcm_usage_in_bytes(self, n_neurons):
         if not self._record_v:
             return 0
+        if self._compression_shift is not None:
+
+            # The compressed record is a time, a baseline and a half-word per
+            # neuron, padded to a word
+            return 4 + 8 + (4 * int(math.ceil(n_neurons / 2.0)))
         return 4
 
     def get_n_cpu_cycles(self, n_neurons):
@@ -69,18 +131,25 @@ class VRecorder(object):
             if missing_data:
                 missing_str += "({}, {}, {}); ".format(x, y, p)
             record_raw = neuron_param_region_data_pointer.read_all()
-            record_length = len(record_raw)
-            n_rows = record_length / ((vertex_slice.n_atoms + 1) * 4)
-            record = (numpy.asarray(record_raw, dtype="uint8").
-                      view(dtype="<i4")).reshape((n_rows,
-                                                  (vertex_slice.n_atoms + 1)))
-            split_record = numpy.array_split(record, [1, 1], 1)
+            if self._compression_shift is not None:
+                record_ticks, record_membrane_potential = \
+                    decode_compressed_v(
+                        record_raw, vertex_slice.n_atoms,
+                        self._compression_shift)
+            else:
+                record_length = len(record_raw)
+                n_rows = record_length / ((vertex_slice.n_atoms + 1) * 4)
+                record = (numpy.asarray(record_raw, dtype="uint8").
+                          view(dtype="<i4")).reshape(
+                    (n_rows, (vertex_slice.n_atoms + 1)))
+                split_record = numpy.array_split(record, [1, 1], 1)
+                record_ticks = split_record[0]
+                record_membrane_potential = split_record[2] / 32767.0
             record_time = numpy.repeat(
-                split_record[0] * float(ms_per_tick), vertex_slice.n_atoms, 1)
+                record_ticks * float(ms_per_tick), vertex_slice.n_atoms, 1)
             record_ids = numpy.tile(
                 numpy.arange(vertex_slice.lo_atom, vertex_slice.hi_atom + 1),
                 len(record_time)).reshape((-1, vertex_slice.n_atoms))
-            record_membrane_potential = split_record[2] / 32767.0
 
             part_data = numpy.dstack(
                 [record_ids, record_time, record_membrane_potential])
@@ -67,6 +67,12 @@ _C_MAIN_BASE_DTCM_USAGE_IN_BYTES = 12
 _C_MAIN_BASE_SDRAM_USAGE_IN_BYTES = 72
 _C_MAIN_BASE_N_CPU_CYCLES = 0
 
+# The words of the neuron parameters region before the global parameters;
+# whether there is a key, the key, the number of neurons, the size of the
+# incoming spike buffer, the voltage compression shift and the number of time
+# steps to run on each timer tick
+_NEURON_PARAMS_HEADER_WORDS = 6
+
 
 @add_metaclass(ABCMeta)
 class AbstractPopulationVertex(
@@ -116,7 +122,13 @@ class AbstractPopulationVertex(
 
         # Set up for recording
         self._spike_recorder = SpikeRecorder(machine_time_step)
-        self._v_recorder = VRecorder(machine_time_step)
+        v_compression_shift = None
+        if config.getboolean("Recording", "compress_v"):
+            v_compression_shift = config.getint(
+                "Recording", "v_compression_shift")
+        self._v_recorder = VRecorder(machine_time_step, v_compression_shift)
+        self._timesteps_per_tick = config.getint(
+            "Simulation", "timesteps_per_timer_tick")
         self._gsyn_recorder = GsynRecorder(machine_time_step)
         self._spike_buffer_max_size = config.getint(
             "Buffers", "spike_buffer_size")
@@ -202,6 +214,15 @@ class AbstractPopulationVertex(
     def maximum_delay_supported_in_ms(self):
         return self._synapse_manager.maximum_delay_supported_in_ms
 
+    def increase_maximum_delay_supported(self, max_delay):
+        """ Support delays of up to max_delay ms without a delay extension\
+            if the DTCM of the cores allows it
+
+        :return: The maximum delay now supported in ms
+        """
+        return self._synapse_manager.increase_maximum_delay_supported(
+            max_delay, min(self.n_atoms, self.get_max_atoms_per_core()))
+
     # @implements AbstractPopulationVertex.get_cpu_usage_for_atoms
     def get_cpu_usage_for_atoms(self, vertex_slice, graph):
         per_neuron_cycles = (
@@ -233,7 +254,8 @@ class AbstractPopulationVertex(
         return (_NEURON_BASE_DTCM_USAGE_IN_BYTES +
                 (per_neuron_usage * vertex_slice.n_atoms) +
                 self._spike_recorder.get_dtcm_usage_in_bytes() +
-                self._v_recorder.get_dtcm_usage_in_bytes() +
+                self._v_recorder.get_dtcm_usage_in_bytes(
+                    vertex_slice.n_atoms) +
                 self._gsyn_recorder.get_dtcm_usage_in_bytes() +
                 self._synapse_manager.get_dtcm_usage_in_bytes(
                     vertex_slice, graph))
@@ -245,8 +267,7 @@ class AbstractPopulationVertex(
         if self._additional_input is not None:
             per_neuron_usage += \
                 self._additional_input.get_sdram_usage_per_neuron_in_bytes()
-        return ((common_constants.DATA_SPECABLE_BASIC_SETUP_INFO_N_WORDS * 4) +
-                ReceiveBuffersToHostBasicImpl.get_recording_data_size(3) +
+        return ((_NEURON_PARAMS_HEADER_WORDS * 4) +
                 (per_neuron_usage * vertex_slice.n_atoms) +
                 self._neuron_model.get_sdram_usage_in_bytes(
                     vertex_slice.n_atoms))
@@ -254,6 +275,8 @@ class AbstractPopulationVertex(
     # @implements AbstractPartitionableVertex.get_sdram_usage_for_atoms
     def get_sdram_usage_for_atoms(self, vertex_slice, graph):
         sdram_requirement = (
+            (common_constants.DATA_SPECABLE_BASIC_SETUP_INFO_N_WORDS * 4) +
+            ReceiveBuffersToHostBasicImpl.get_recording_data_size(3) +
             self._get_sdram_usage_for_neuron_params(vertex_slice) +
             ReceiveBuffersToHostBasicImpl.get_buffer_state_region_size(3) +
             PopulationPartitionedVertex.get_provenance_data_size(
@@ -380,6 +403,12 @@ class AbstractPopulationVertex(
         # Write the size of the incoming spike buffer
         spec.write_value(data=self._incoming_spike_buffer_size)
 
+        # Write how the voltage is to be compressed when recorded
+        spec.write_value(data=self._v_recorder.compression_shift)
+
+        # Write the number of time steps to run on each timer tick
+        spec.write_value(data=self._timesteps_per_tick)
+
         # Write the global parameters
         global_params = self._neuron_model.get_global_parameters()
         for param in global_params:
@@ -626,6 +655,14 @@ class AbstractPopulationVertex(
     def synapse_dynamics(self, synapse_dynamics):
         self._synapse_manager.synapse_dynamics = synapse_dynamics
 
+    def freeze_plasticity(
+            self, transceiver=None, placements=None, graph_mapper=None):
+        """ Stop the plastic synapses of the vertex from learning; if the\
+            transceiver is given, the change is also written to the machine
+        """
+        self._synapse_manager.freeze_plasticity(
+            self, transceiver, placements, graph_mapper)
+
     def add_pre_run_connection_holder(
             self, connection_holder, edge, synapse_info):
         self._synapse_manager.add_pre_run_connection_holder(
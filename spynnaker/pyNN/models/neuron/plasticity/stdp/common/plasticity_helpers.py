@@ -1,7 +1,6 @@
 import math
 import logging
-
-from data_specification.enums.data_type import DataType
+import numpy
 
 from spinn_front_end_common.utilities.utility_objs.provenance_data_item \
     import ProvenanceDataItem
@@ -11,33 +10,107 @@ logger = logging.getLogger(__name__)
 # Default value of fixed-point one for STDP
 STDP_FIXED_POINT_ONE = (1 << 11)
 
+# The most entries an exponential decay lookup table can have
+MAX_EXP_LUT_SIZE = 256
+
+# The fields of the word describing each exponential decay lookup table
+_EXP_LUT_TIME_SHIFT_SHIFT = 16
+_EXP_LUT_INTERPOLATE_BIT = 21
+_EXP_LUT_SHARED_SHIFT = 24
+
 
 def float_to_fixed(value, fixed_point_one):
     return int(round(float(value) * float(fixed_point_one)))
 
 
-def write_exp_lut(spec, time_constant, size, shift,
-                  fixed_point_one=STDP_FIXED_POINT_ONE):
-    # Calculate time constant reciprocal
-    time_constant_reciprocal = 1.0 / float(time_constant)
+def get_exp_lut_size_and_shift(
+        time_constant, max_size=MAX_EXP_LUT_SIZE,
+        fixed_point_one=STDP_FIXED_POINT_ONE):
+    """ Choose the size of an exponential decay lookup table, and the shift\
+        applied to times to index it, so that the table reaches the time\
+        at which the decay rounds to zero with the finest resolution that\
+        fits in the maximum size
+
+    :return: The size and the time shift
+    """
+
+    # The first time step at which the decay is less than half of the
+    # smallest fixed-point value
+    end_time = int(math.floor(
+        float(time_constant) * math.log(2.0 * fixed_point_one))) + 1
+
+    shift = 0
+    while int(math.ceil(float(end_time) / (1 << shift))) + 1 > max_size:
+        shift += 1
+    return int(math.ceil(float(end_time) / (1 << shift))) + 1, shift
+
+
+def _get_exp_lut(time_constant, size, shift, fixed_point_one):
+    times = numpy.arange(size, dtype="float") * (1 << shift)
+    return numpy.rint(
+        numpy.exp(-times / float(time_constant)) *
+        fixed_point_one).astype("int16")
+
+
+def get_exp_luts(
+        time_constants, max_size=MAX_EXP_LUT_SIZE,
+        fixed_point_one=STDP_FIXED_POINT_ONE):
+    """ Get the exponential decay lookup tables for a list of time constants
+
+    :return: A list of the size, time shift, entries and index of an\
+        earlier identical table (or None) of each table
+    """
+    luts = list()
+    for time_constant in time_constants:
+        size, shift = get_exp_lut_size_and_shift(
+            time_constant, max_size, fixed_point_one)
+        entries = _get_exp_lut(time_constant, size, shift, fixed_point_one)
+        shared = None
+        for i, (other_size, other_shift, other_entries, _) in enumerate(luts):
+            if (other_size == size and other_shift == shift and
+                    numpy.array_equal(other_entries, entries)):
+                shared = i
+                break
+        luts.append((size, shift, entries, shared))
+    return luts
+
 
-    # Generate LUT
-    last_value = None
-    for i in range(size):
+def get_exp_luts_sdram_usage_in_bytes(luts):
+    """ Get the size of a list of lookup tables from get_exp_luts
+    """
+    size = 0
+    for (n_entries, _, _, shared) in luts:
+        size += 4
+        if shared is None:
+            size += int(math.ceil(n_entries / 2.0)) * 4
+    return size
 
-        # Apply shift to get time from index
-        time = (i << shift)
 
-        # Multiply by time constant and calculate negative exponential
-        value = float(time) * time_constant_reciprocal
-        exp_float = math.exp(-value)
+def write_exp_luts(spec, luts, interpolate=False):
+    """ Write a list of lookup tables from get_exp_luts; each is a word\
+        describing the table, followed by the entries of the table unless\
+        it is identical to an earlier one
 
-        # Convert to fixed-point and write to spec
-        last_value = float_to_fixed(exp_float, fixed_point_one)
-        spec.write_value(data=last_value, data_type=DataType.INT16)
+    :param interpolate: True if the values between entries of tables which\
+        are sampled less than every time step are to be interpolated
+    :return: The last entry of each table as a float (should be 0)
+    """
+    last_entries = list()
+    for (size, shift, entries, shared) in luts:
+        description = size | (shift << _EXP_LUT_TIME_SHIFT_SHIFT)
+        if interpolate and shift > 0:
+            description |= (1 << _EXP_LUT_INTERPOLATE_BIT)
+        if shared is not None:
+            description |= ((shared + 1) << _EXP_LUT_SHARED_SHIFT)
+        spec.write_value(data=description)
 
-    # return last value reverted to float (should be 0 if correct)
-    return float(last_value) / float(fixed_point_one)
+        if shared is None:
+            padded = numpy.zeros(
+                int(math.ceil(size / 2.0)) * 2, dtype="int16")
+            padded[:size] = entries
+            spec.write_array(padded.view("uint32"))
+        last_entries.append(float(entries[-1]) / float(STDP_FIXED_POINT_ONE))
+    return last_entries
 
 
 def get_lut_provenance(
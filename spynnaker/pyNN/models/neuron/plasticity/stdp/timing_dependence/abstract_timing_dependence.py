@@ -22,6 +22,18 @@ class AbstractTimingDependence(object):
         """ The number of bytes used by the pre-trace of the rule per neuron
         """
 
+    @abstractproperty
+    def post_trace_n_bytes(self):
+        """ The number of bytes used by each post-trace of the rule in the\
+            post-synaptic event history
+        """
+
+    @abstractproperty
+    def post_event_window(self):
+        """ The time in ms between a pre- and post-synaptic spike over which\
+            the pairing still has a significant effect on the rule
+        """
+
     @abstractmethod
     def get_parameters_sdram_usage_in_bytes(self):
         """ Get the amount of SDRAM used by the parameters of this rule
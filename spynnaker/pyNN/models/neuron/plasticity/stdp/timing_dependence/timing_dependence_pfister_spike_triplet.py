@@ -9,26 +9,24 @@ from spynnaker.pyNN.models.neuron.plasticity.stdp.synapse_structure\
 import logging
 logger = logging.getLogger(__name__)
 
-LOOKUP_TAU_PLUS_SIZE = 256
-LOOKUP_TAU_PLUS_SHIFT = 0
-LOOKUP_TAU_MINUS_SIZE = 256
-LOOKUP_TAU_MINUS_SHIFT = 0
-LOOKUP_TAU_X_SIZE = 256
-LOOKUP_TAU_X_SHIFT = 2
-LOOKUP_TAU_Y_SIZE = 256
-LOOKUP_TAU_Y_SHIFT = 2
-
 
 class TimingDependencePfisterSpikeTriplet(AbstractTimingDependence):
 
     # noinspection PyPep8Naming
-    def __init__(self, tau_plus, tau_minus, tau_x, tau_y):
+    def __init__(self, tau_plus, tau_minus, tau_x, tau_y,
+                 lut_interpolation=False):
         AbstractTimingDependence.__init__(self)
 
         self._tau_plus = tau_plus
         self._tau_minus = tau_minus
         self._tau_x = tau_x
         self._tau_y = tau_y
+        self._lut_interpolation = lut_interpolation
+
+        # The lookup tables are sized for the time constants, and shared if
+        # the time constants are equal
+        self._luts = plasticity_helpers.get_exp_luts(
+            [self._tau_plus, self._tau_minus, self._tau_x, self._tau_y])
 
         self._synapse_structure = SynapseStructureWeightOnly()
 
@@ -62,7 +60,9 @@ class TimingDependencePfisterSpikeTriplet(AbstractTimingDependence):
             (self._tau_plus == timing_dependence.tau_plus) and
             (self._tau_minus == timing_dependence.tau_minus) and
             (self._tau_x == timing_dependence.tau_x) and
-            (self._tau_y == timing_dependence.tau_y))
+            (self._tau_y == timing_dependence.tau_y) and
+            (self._lut_interpolation ==
+             timing_dependence._lut_interpolation))
 
     @property
     def vertex_executable_suffix(self):
@@ -74,9 +74,22 @@ class TimingDependencePfisterSpikeTriplet(AbstractTimingDependence):
         # Triplet rule trace entries consists of two 16-bit traces - R1 and R2
         return 4
 
+    @property
+    def post_trace_n_bytes(self):
+
+        # Triplet rule trace entries consists of two 16-bit traces - O1 and O2
+        return 4
+
+    @property
+    def post_event_window(self):
+
+        # Beyond this, the potentiation from a pairing has decayed to less
+        # than 1% of its peak
+        return 5.0 * self._tau_plus
+
     def get_parameters_sdram_usage_in_bytes(self):
-        return (2 * (LOOKUP_TAU_PLUS_SIZE + LOOKUP_TAU_MINUS_SIZE +
-                     LOOKUP_TAU_X_SIZE + LOOKUP_TAU_Y_SIZE))
+        return plasticity_helpers.get_exp_luts_sdram_usage_in_bytes(
+            self._luts)
 
     @property
     def n_weight_terms(self):
@@ -90,16 +103,10 @@ class TimingDependencePfisterSpikeTriplet(AbstractTimingDependence):
                 "STDP LUT generation currently only supports 1ms timesteps")
 
         # Write lookup tables
-        self._tau_plus_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self._tau_plus, LOOKUP_TAU_PLUS_SIZE,
-            LOOKUP_TAU_PLUS_SHIFT)
-        self._tau_minus_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self._tau_minus, LOOKUP_TAU_MINUS_SIZE,
-            LOOKUP_TAU_MINUS_SHIFT)
-        self._tau_x_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self._tau_x, LOOKUP_TAU_X_SIZE, LOOKUP_TAU_X_SHIFT)
-        self._tau_y_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self._tau_y, LOOKUP_TAU_Y_SIZE, LOOKUP_TAU_Y_SHIFT)
+        (self._tau_plus_last_entry, self._tau_minus_last_entry,
+         self._tau_x_last_entry, self._tau_y_last_entry) = \
+            plasticity_helpers.write_exp_luts(
+                spec, self._luts, self._lut_interpolation)
 
     @property
     def synaptic_structure(self):
@@ -10,19 +10,21 @@ from spynnaker.pyNN.models.neuron.plasticity.stdp.synapse_structure\
 import logging
 logger = logging.getLogger(__name__)
 
-LOOKUP_TAU_PLUS_SIZE = 256
-LOOKUP_TAU_PLUS_SHIFT = 0
-LOOKUP_TAU_MINUS_SIZE = 256
-LOOKUP_TAU_MINUS_SHIFT = 0
-
 
 class TimingDependenceSpikePair(AbstractTimingDependence):
 
-    def __init__(self, tau_plus=20.0, tau_minus=20.0, nearest=False):
+    def __init__(self, tau_plus=20.0, tau_minus=20.0, nearest=False,
+                 lut_interpolation=False):
         AbstractTimingDependence.__init__(self)
         self._tau_plus = tau_plus
         self._tau_minus = tau_minus
         self._nearest = nearest
+        self._lut_interpolation = lut_interpolation
+
+        # The lookup tables are sized for the time constants, and shared if
+        # the time constants are equal
+        self._luts = plasticity_helpers.get_exp_luts(
+            [self._tau_plus, self._tau_minus])
 
         self._synapse_structure = SynapseStructureWeightOnly()
 
@@ -48,7 +50,9 @@ class TimingDependenceSpikePair(AbstractTimingDependence):
         return (
             (self._tau_plus == timing_dependence._tau_plus) and
             (self._tau_minus == timing_dependence._tau_minus) and
-            (self._nearest == timing_dependence._nearest))
+            (self._nearest == timing_dependence._nearest) and
+            (self._lut_interpolation ==
+             timing_dependence._lut_interpolation))
 
     @property
     def vertex_executable_suffix(self):
@@ -61,8 +65,23 @@ class TimingDependenceSpikePair(AbstractTimingDependence):
         # Neighbours are considered and, a single 16-bit R1 trace
         return 0 if self._nearest else 2
 
+    @property
+    def post_trace_n_bytes(self):
+
+        # As with the pre-synaptic trace, a single 16-bit trace unless only
+        # the nearest neighbours are considered
+        return 0 if self._nearest else 2
+
+    @property
+    def post_event_window(self):
+
+        # Beyond this, the potentiation from a pairing has decayed to less
+        # than 1% of its peak
+        return 5.0 * self._tau_plus
+
     def get_parameters_sdram_usage_in_bytes(self):
-        return 2 * (LOOKUP_TAU_PLUS_SIZE + LOOKUP_TAU_MINUS_SIZE)
+        return plasticity_helpers.get_exp_luts_sdram_usage_in_bytes(
+            self._luts)
 
     @property
     def n_weight_terms(self):
@@ -76,12 +95,9 @@ class TimingDependenceSpikePair(AbstractTimingDependence):
                 "STDP LUT generation currently only supports 1ms timesteps")
 
         # Write lookup tables
-        self._tau_plus_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self._tau_plus, LOOKUP_TAU_PLUS_SIZE,
-            LOOKUP_TAU_PLUS_SHIFT)
-        self._tau_minus_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self._tau_minus, LOOKUP_TAU_MINUS_SIZE,
-            LOOKUP_TAU_MINUS_SHIFT)
+        (self._tau_plus_last_entry, self._tau_minus_last_entry) = \
+            plasticity_helpers.write_exp_luts(
+                spec, self._luts, self._lut_interpolation)
 
     @property
     def synaptic_structure(self):
@@ -15,13 +15,16 @@ from spinn_front_end_common.abstract_models.abstract_recordable \
 
 # spynnaker imports
 from spynnaker.pyNN.utilities import constants
+from spynnaker.pyNN.models.common.provides_profiler_provenance_impl \
+    import ProvidesProfilerProvenanceImpl
 
 from enum import Enum
 
 
 class PopulationPartitionedVertex(
         PartitionedVertex, ReceiveBuffersToHostBasicImpl,
-        ProvidesProvenanceDataFromMachineImpl, AbstractRecordable):
+        ProvidesProvenanceDataFromMachineImpl,
+        ProvidesProfilerProvenanceImpl, AbstractRecordable):
 
     # entries for the provenance data generated by standard neuron models
     EXTRA_PROVENANCE_DATA_ENTRIES = Enum(
@@ -29,9 +32,15 @@ class PopulationPartitionedVertex(
         names=[("PRE_SYNAPTIC_EVENT_COUNT", 0),
                ("SATURATION_COUNT", 1),
                ("BUFFER_OVERFLOW_COUNT", 2),
-               ("CURRENT_TIMER_TIC", 3)])
+               ("CURRENT_TIMER_TIC", 3),
+               ("TIMER_TIC_OVERRUN_COUNT", 4),
+               ("LATE_SPIKE_COUNT", 5),
+               ("MAX_SPIKE_LATENESS", 6),
+               ("TRUNCATED_WINDOW_COUNT", 7),
+               ("PROFILER_DATA_START", 8)])
 
-    N_ADDITIONAL_PROVENANCE_DATA_ITEMS = 4
+    N_ADDITIONAL_PROVENANCE_DATA_ITEMS = (
+        8 + constants.PROFILER_PROVENANCE_WORDS)
 
     def __init__(
             self, resources_required, label, is_recording, constraints=None):
@@ -62,6 +71,14 @@ class PopulationPartitionedVertex(
             self.EXTRA_PROVENANCE_DATA_ENTRIES.PRE_SYNAPTIC_EVENT_COUNT.value]
         last_timer_tick = provenance_data[
             self.EXTRA_PROVENANCE_DATA_ENTRIES.CURRENT_TIMER_TIC.value]
+        n_timer_tick_overruns = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.TIMER_TIC_OVERRUN_COUNT.value]
+        n_late_spikes = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.LATE_SPIKE_COUNT.value]
+        max_spike_lateness = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.MAX_SPIKE_LATENESS.value]
+        n_truncated_post_windows = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.TRUNCATED_WINDOW_COUNT.value]
 
         label, x, y, p, names = self._get_placement_details(placement)
 
@@ -93,4 +110,46 @@ class PopulationPartitionedVertex(
         provenance_items.append(ProvenanceDataItem(
             self._add_name(names, "Last_timer_tic_the_core_ran_to"),
             last_timer_tick))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Times_the_timer_tic_overran"),
+            n_timer_tick_overruns,
+            report=n_timer_tick_overruns > 0,
+            message=(
+                "The time steps of {} on {}, {}, {} did not complete within "
+                "the timer tic on {} occasions. Please increase the "
+                "time_scale_factor, decrease the timesteps_per_timer_tick "
+                "value located within the .spynnaker.cfg file or decrease "
+                "the number of neurons per core.".format(
+                    label, x, y, p, n_timer_tick_overruns))))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Late_spikes"),
+            n_late_spikes,
+            report=n_late_spikes > 0,
+            message=(
+                "{} spikes received by {} on {}, {}, {} were taken from the "
+                "input buffer after the end of the timer tic in which they "
+                "arrived, so may have been added with a longer delay than "
+                "requested. Please increase the time_scale_factor or "
+                "decrease the number of neurons per core.".format(
+                    n_late_spikes, label, x, y, p))))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Max_spike_lateness_in_microseconds"),
+            max_spike_lateness))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(
+                names, "Plastic_updates_missing_post_synaptic_events"),
+            n_truncated_post_windows,
+            report=n_truncated_post_windows > 0,
+            message=(
+                "{} plastic synapse updates on {} on {}, {}, {} missed "
+                "post-synaptic events which had been dropped from the "
+                "post-synaptic event history, so the learning will be "
+                "inaccurate.  Please increase the post_event_history_depth "
+                "of the STDP mechanism, or the spikes_per_second value "
+                "located within the .spynnaker.cfg file.".format(
+                    n_truncated_post_windows, label, x, y, p))))
+        provenance_items.extend(self._get_profiler_provenance_items(
+            provenance_data[
+                self.EXTRA_PROVENANCE_DATA_ENTRIES.PROFILER_DATA_START.value:],
+            label, x, y, p, names))
         return provenance_items
@@ -37,6 +37,12 @@ class AbstractSynapseDynamics(object):
         """ Write the synapse parameters to the spec
         """
 
+    def get_dtcm_usage_in_bytes(self, n_neurons):
+        """ Get the DTCM used by the synapse dynamics for the given number\
+            of neurons
+        """
+        return 0
+
     def get_provenance_data(self, pre_population_label, post_population_label):
         """ Get the provenance data from this synapse dynamics object
         """
@@ -3,6 +3,7 @@ import math
 
 from spynnaker.pyNN.models.neuron.synapse_dynamics\
     .abstract_static_synapse_dynamics import AbstractStaticSynapseDynamics
+from spynnaker.pyNN.utilities import constants
 
 
 class SynapseDynamicsStatic(AbstractStaticSynapseDynamics):
@@ -36,7 +37,8 @@ class SynapseDynamicsStatic(AbstractStaticSynapseDynamics):
         fixed_fixed = (
             ((numpy.rint(numpy.abs(connections["weight"])).astype("uint32") &
               0xFFFF) << 16) |
-            ((connections["delay"].astype("uint32") & 0xF) <<
+            ((connections["delay"].astype("uint32") &
+              constants.SYNAPSE_DELAY_MASK) <<
              (8 + n_synapse_type_bits)) |
             (connections["synapse_type"].astype("uint32") << 8) |
             ((connections["target"] - post_vertex_slice.lo_atom) & 0xFF))
@@ -67,7 +69,9 @@ class SynapseDynamicsStatic(AbstractStaticSynapseDynamics):
             i, ff_size[i]) for i in range(len(ff_size))])
         connections["target"] = (data & 0xFF) + post_vertex_slice.lo_atom
         connections["weight"] = (data >> 16) & 0xFFFF
-        connections["delay"] = (data >> (8 + n_synapse_type_bits)) & 0xF
-        connections["delay"][connections["delay"] == 0] = 16
+        connections["delay"] = ((data >> (8 + n_synapse_type_bits)) &
+                                constants.SYNAPSE_DELAY_MASK)
+        connections["delay"][connections["delay"] == 0] = \
+            1 << constants.SYNAPSE_DELAY_BITS
 
         return connections
@@ -3,6 +3,8 @@ import numpy
 
 from spynnaker.pyNN.models.neuron.synapse_dynamics\
     .abstract_plastic_synapse_dynamics import AbstractPlasticSynapseDynamics
+from spynnaker.pyNN.utilities import conf
+from spynnaker.pyNN.utilities import constants
 
 # How large are the time-stamps stored with each event
 TIME_STAMP_BYTES = 4
@@ -10,18 +12,50 @@ TIME_STAMP_BYTES = 4
 # When not using the MAD scheme, how many pre-synaptic events are buffered
 NUM_PRE_SYNAPTIC_EVENTS = 4
 
+# The limits on the number of entries in each post-synaptic event history
+MIN_POST_EVENT_HISTORY_DEPTH = 4
+MAX_POST_EVENT_HISTORY_DEPTH = 256
+
+# The number of standard deviations above the expected number of
+# post-synaptic spikes in a window to allow for in the event history
+POST_EVENT_HISTORY_SIGMA = 3.0
+
+# The size of the fixed part of each post-synaptic event history (count,
+# head, dropped time, base time and the pointers to the times and traces)
+POST_EVENT_HISTORY_HEADER_BYTES = 24
+
+
+def get_post_event_history_depth(spikes_per_second, window):
+    """ Get the number of entries needed in the post-synaptic event history\
+        to hold the spikes of a neuron firing at the given rate within the\
+        given window, plus the initial entry
+
+    :param spikes_per_second: The expected firing rate of the neuron in Hz
+    :param window: The time window in ms
+    :return: A power of two number of entries
+    """
+    expected = (spikes_per_second * window) / 1000.0
+    n_entries = int(math.ceil(
+        expected + (POST_EVENT_HISTORY_SIGMA * math.sqrt(expected)))) + 1
+    depth = MIN_POST_EVENT_HISTORY_DEPTH
+    while depth < n_entries and depth < MAX_POST_EVENT_HISTORY_DEPTH:
+        depth *= 2
+    return depth
+
 
 class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
 
     def __init__(
             self, timing_dependence=None, weight_dependence=None,
             voltage_dependence=None,
-            dendritic_delay_fraction=1.0, mad=True):
+            dendritic_delay_fraction=1.0, mad=True,
+            post_event_history_depth=None):
         AbstractPlasticSynapseDynamics.__init__(self)
         self._timing_dependence = timing_dependence
         self._weight_dependence = weight_dependence
         self._dendritic_delay_fraction = float(dendritic_delay_fraction)
         self._mad = mad
+        self._post_event_history_depth = post_event_history_depth
 
         if (self._dendritic_delay_fraction < 0.5 or
                 self._dendritic_delay_fraction > 1.0):
@@ -37,6 +71,19 @@ class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
             raise NotImplementedError(
                 "Voltage dependence has not been implemented")
 
+        # If not specified, size the post-synaptic event history for the
+        # spikes expected within the time window of the timing rule
+        if self._post_event_history_depth is None:
+            self._post_event_history_depth = get_post_event_history_depth(
+                conf.config.getfloat("Simulation", "spikes_per_second"),
+                self._timing_dependence.post_event_window)
+        elif (self._post_event_history_depth < 2 or
+                (self._post_event_history_depth &
+                 (self._post_event_history_depth - 1)) != 0):
+            raise NotImplementedError(
+                "post_event_history_depth must be a power of two of at"
+                " least 2")
+
     @property
     def weight_dependence(self):
         return self._weight_dependence
@@ -49,6 +96,10 @@ class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
     def dendritic_delay_fraction(self):
         return self._dendritic_delay_fraction
 
+    @property
+    def post_event_history_depth(self):
+        return self._post_event_history_depth
+
     def is_same_as(self, synapse_dynamics):
         if not isinstance(synapse_dynamics, SynapseDynamicsSTDP):
             return False
@@ -59,7 +110,9 @@ class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
                 synapse_dynamics._weight_dependence) and
             (self._dendritic_delay_fraction ==
              synapse_dynamics._dendritic_delay_fraction) and
-            (self._mad == synapse_dynamics._mad))
+            (self._mad == synapse_dynamics._mad) and
+            (self._post_event_history_depth ==
+             synapse_dynamics._post_event_history_depth))
 
     def are_weights_signed(self):
         return False
@@ -71,7 +124,9 @@ class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
         return name
 
     def get_parameters_sdram_usage_in_bytes(self, n_neurons, n_synapse_types):
-        size = 0
+
+        # The size of the post-synaptic event history comes first
+        size = 4
 
         size += self._timing_dependence.get_parameters_sdram_usage_in_bytes()
         size += self._weight_dependence.get_parameters_sdram_usage_in_bytes(
@@ -85,6 +140,9 @@ class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
         # Switch focus to the region:
         spec.switch_write_focus(region)
 
+        # Write the size of the post-synaptic event history
+        spec.write_value(data=self._post_event_history_depth)
+
         # Write timing dependence parameters to region
         self._timing_dependence.write_parameters(
             spec, machine_time_step, weight_scales)
@@ -94,23 +152,44 @@ class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
             spec, machine_time_step, weight_scales,
             self._timing_dependence.n_weight_terms)
 
+    def get_dtcm_usage_in_bytes(self, n_neurons):
+
+        # Each neuron has a post-synaptic event history with a time and a
+        # trace for each entry; this is an upper bound when the binaries are
+        # built with POST_EVENT_TIMES_COMPRESSED, which stores 16-bit times
+        size = n_neurons * (
+            POST_EVENT_HISTORY_HEADER_BYTES +
+            (self._post_event_history_depth *
+             (TIME_STAMP_BYTES + self._timing_dependence.post_trace_n_bytes)))
+
+        # The MAD scheme also caches the start of the last window requested
+        # from each history in a byte
+        if self._mad:
+            size += n_neurons
+        return size
+
     @property
     def _n_header_bytes(self):
         if self._mad:
 
             # If we're using MAD, the header contains a single timestamp and
             # pre-trace
-            return (
+            n_bytes = (
                 TIME_STAMP_BYTES + self.timing_dependence.pre_trace_n_bytes)
         else:
 
             # Otherwise, headers consist of a counter followed by
             # NUM_PRE_SYNAPTIC_EVENTS timestamps and pre-traces
-            return (
+            n_bytes = (
                 4 + (NUM_PRE_SYNAPTIC_EVENTS *
                      (TIME_STAMP_BYTES +
                       self.timing_dependence.pre_trace_n_bytes)))
 
+        # The header is a structure padded to whole words on the core, so the
+        # plastic synapses which follow it start on a word boundary, in
+        # parallel with the control words in the fixed-plastic region
+        return int(math.ceil(n_bytes / 4.0)) * 4
+
     def get_n_words_for_plastic_connections(self, n_connections):
         synapse_structure = self._timing_dependence.synaptic_structure
         fp_size_words = \
@@ -131,12 +210,17 @@ class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
         axonal_delays = (
             connections["delay"] * (1.0 - self._dendritic_delay_fraction))
 
-        # Get the fixed data
+        # Get the fixed data; the axonal delay gets whatever bits of the
+        # 16-bit control word are left above the dendritic delay
+        axonal_delay_shift = (
+            8 + n_synapse_type_bits + constants.SYNAPSE_DELAY_BITS)
+        axonal_delay_mask = (1 << max(16 - axonal_delay_shift, 0)) - 1
         fixed_plastic = (
-            ((dendritic_delays.astype("uint16") & 0xF) <<
+            ((dendritic_delays.astype("uint16") &
+              constants.SYNAPSE_DELAY_MASK) <<
              (8 + n_synapse_type_bits)) |
-            ((axonal_delays.astype("uint16") & 0xF) <<
-             (12 + n_synapse_type_bits)) |
+            ((axonal_delays.astype("uint16") & axonal_delay_mask) <<
+             axonal_delay_shift) |
             (connections["synapse_type"].astype("uint16") << 8) |
             ((connections["target"].astype("uint16") -
               post_vertex_slice.lo_atom) & 0xFF))
@@ -197,8 +281,10 @@ class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
         connections["target"] = (data_fixed & 0xFF) + post_vertex_slice.lo_atom
         connections["weight"] = synapse_structure.read_synaptic_data(
             fp_size, pp_without_headers)
-        connections["delay"] = (data_fixed >> (8 + n_synapse_type_bits)) & 0xF
-        connections["delay"][connections["delay"] == 0] = 16
+        connections["delay"] = ((data_fixed >> (8 + n_synapse_type_bits)) &
+                                constants.SYNAPSE_DELAY_MASK)
+        connections["delay"][connections["delay"] == 0] = \
+            1 << constants.SYNAPSE_DELAY_BITS
         return connections
 
     def get_weight_mean(
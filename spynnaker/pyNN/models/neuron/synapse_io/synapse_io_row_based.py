@@ -7,11 +7,18 @@ from spynnaker.pyNN.models.neural_projections.connectors.abstract_connector \
     import AbstractConnector
 from spynnaker.pyNN.models.neuron.synapse_dynamics\
     .abstract_static_synapse_dynamics import AbstractStaticSynapseDynamics
+from spynnaker.pyNN.models.neuron.synapse_dynamics.synapse_dynamics_static \
+    import SynapseDynamicsStatic
 from spynnaker.pyNN.models.neuron.synapse_io.abstract_synapse_io \
     import AbstractSynapseIO
+from spynnaker.pyNN.utilities import constants
+from spynnaker.pyNN import exceptions
 
 _N_HEADER_WORDS = 3
 
+# Used to read plastic rows which have been frozen into static rows
+_FROZEN_SYNAPSE_DYNAMICS = SynapseDynamicsStatic()
+
 
 class SynapseIORowBased(AbstractSynapseIO):
     """ A SynapseRowIO implementation that uses a row for each source neuron,
@@ -25,10 +32,34 @@ class SynapseIORowBased(AbstractSynapseIO):
         AbstractSynapseIO.__init__(self)
         self._machine_time_step = machine_time_step
 
+        # The number of bits of the time step used to index the ring buffers
+        self._ring_buffer_delay_bits = int(math.log(
+            constants.MAX_SUPPORTED_DELAY_TICS, 2))
+
+    @property
+    def ring_buffer_delay_bits(self):
+        return self._ring_buffer_delay_bits
+
+    @ring_buffer_delay_bits.setter
+    def ring_buffer_delay_bits(self, ring_buffer_delay_bits):
+        if ring_buffer_delay_bits > constants.SYNAPSE_DELAY_BITS:
+            raise exceptions.SynapticConfigurationException(
+                "The ring buffers cannot have more than {} delay bits".format(
+                    constants.SYNAPSE_DELAY_BITS))
+        self._ring_buffer_delay_bits = ring_buffer_delay_bits
+
     def get_maximum_delay_supported_in_ms(self):
 
-        # There are 16 slots, one per time step
-        return 16 * (self._machine_time_step / 1000.0)
+        # There is a ring buffer slot for each time step
+        return ((1 << self._ring_buffer_delay_bits) *
+                (self._machine_time_step / 1000.0))
+
+    def _get_delay_stage_length_in_ms(self):
+
+        # Each stage of a delay extension delays by a fixed number of time
+        # steps, whatever the delay supported by the ring buffers
+        return (constants.MAX_TIMER_TICS_SUPPORTED_PER_BLOCK *
+                (self._machine_time_step / 1000.0))
 
     def _n_words(self, n_bytes):
         return math.ceil(float(n_bytes) / 4.0)
@@ -42,7 +73,8 @@ class SynapseIORowBased(AbstractSynapseIO):
         # that will be needed by any row for both rows with delay extensions
         # and rows without
         max_delay_supported = self.get_maximum_delay_supported_in_ms()
-        max_delay = max_delay_supported * (n_delay_stages + 1)
+        max_delay = (max_delay_supported +
+                     self._get_delay_stage_length_in_ms() * n_delay_stages)
 
         # delay point where delay extensions start
         min_delay_for_delay_extension = (
@@ -215,13 +247,15 @@ class SynapseIORowBased(AbstractSynapseIO):
         if len(delayed_connections) > 0:
 
             # Get the delay stages and which row each delayed connection will
-            # go into
-            stages = numpy.floor((numpy.round(
-                delayed_connections["delay"] - 1.0)) / max_delay)
+            # go into; each stage takes off a fixed number of time steps,
+            # leaving a delay the ring buffers can handle
+            stage_length = constants.MAX_TIMER_TICS_SUPPORTED_PER_BLOCK
+            stages = numpy.ceil(
+                (delayed_connections["delay"] - max_delay) / stage_length)
             delayed_row_indices = (
                 (delayed_connections["source"] - pre_vertex_slice.lo_atom) +
                 ((stages - 1) * pre_vertex_slice.n_atoms))
-            delayed_connections["delay"] -= max_delay * stages
+            delayed_connections["delay"] -= stage_length * stages
             delayed_source_ids = (
                 delayed_connections["source"] - pre_vertex_slice.lo_atom)
 
@@ -306,7 +340,9 @@ class SynapseIORowBased(AbstractSynapseIO):
                 row_stage = numpy.array([
                     (i / pre_vertex_slice.n_atoms)
                     for i in range(len(n_synapses))], dtype="uint32")
-                row_min_delay = (row_stage + 1) * 16
+                row_min_delay = (
+                    (row_stage + 1) *
+                    constants.MAX_TIMER_TICS_SUPPORTED_PER_BLOCK)
                 connection_min_delay = numpy.concatenate([
                     numpy.repeat(row_min_delay[i], n_synapses[i])
                     for i in range(len(n_synapses))])
@@ -324,34 +360,23 @@ class SynapseIORowBased(AbstractSynapseIO):
 
             # Read plastic data
             if row_data is not None:
-                pp_size, pp_data, fp_size, fp_data = self._get_plastic_data(
-                    row_data, dynamics)
-                undelayed_connections = dynamics.read_plastic_synaptic_data(
-                    post_vertex_slice, n_synapse_types, pp_size, pp_data,
-                    fp_size, fp_data)
+                undelayed_connections = self._read_plastic_rows(
+                    row_data, dynamics, post_vertex_slice, n_synapse_types)
                 undelayed_connections["source"] += pre_vertex_slice.lo_atom
                 connections.append(undelayed_connections)
 
             if delayed_row_data is not None:
-                pp_size, pp_data, fp_size, fp_data = self._get_plastic_data(
-                    delayed_row_data, dynamics)
-                delayed_connections = dynamics.read_plastic_synaptic_data(
-                    post_vertex_slice, n_synapse_types, pp_size, pp_data,
-                    fp_size, fp_data)
+                delayed_connections = self._read_plastic_rows(
+                    delayed_row_data, dynamics, post_vertex_slice,
+                    n_synapse_types)
 
                 # Use the row index to work out the actual delay and source
-                n_synapses = dynamics.get_n_synapses_in_rows(pp_size, fp_size)
-                row_stage = numpy.array([
-                    (i / pre_vertex_slice.n_atoms)
-                    for i in range(len(n_synapses))], dtype="uint32")
-                row_min_delay = (row_stage + 1) * 16
-                connection_min_delay = numpy.concatenate([
-                    numpy.repeat(row_min_delay[i], n_synapses[i])
-                    for i in range(len(n_synapses))])
-                connection_source_extra = numpy.concatenate([
-                    numpy.repeat(
-                        row_stage[i] * pre_vertex_slice.n_atoms, n_synapses[i])
-                    for i in range(len(n_synapses))])
+                row_stage = (
+                    delayed_connections["source"] / pre_vertex_slice.n_atoms)
+                connection_min_delay = (
+                    (row_stage + 1) *
+                    constants.MAX_TIMER_TICS_SUPPORTED_PER_BLOCK)
+                connection_source_extra = row_stage * pre_vertex_slice.n_atoms
 
                 delayed_connections["source"] -= connection_source_extra
                 delayed_connections["source"] += pre_vertex_slice.lo_atom
@@ -377,5 +402,40 @@ class SynapseIORowBased(AbstractSynapseIO):
         # Return the connections
         return connections
 
+    def _read_plastic_rows(
+            self, row_data, dynamics, post_vertex_slice, n_synapse_types):
+        """ Read rows of plastic synapses; any row with an empty plastic\
+            region has been rewritten as a row of static synapses on the\
+            machine since plasticity was frozen, and is read as such
+
+        :return: The connections, with the source being the index of the row
+        """
+        frozen = (row_data[:, 0] == 0)
+        connections = list()
+
+        plastic_rows = numpy.flatnonzero(~frozen)
+        if len(plastic_rows) > 0:
+            pp_size, pp_data, fp_size, fp_data = self._get_plastic_data(
+                row_data[plastic_rows], dynamics)
+            plastic_connections = dynamics.read_plastic_synaptic_data(
+                post_vertex_slice, n_synapse_types, pp_size, pp_data,
+                fp_size, fp_data)
+            plastic_connections["source"] = plastic_rows[
+                plastic_connections["source"]]
+            connections.append(plastic_connections)
+
+        frozen_rows = numpy.flatnonzero(frozen)
+        if len(frozen_rows) > 0:
+            ff_size, ff_data = self._get_static_data(
+                row_data[frozen_rows], _FROZEN_SYNAPSE_DYNAMICS)
+            frozen_connections = \
+                _FROZEN_SYNAPSE_DYNAMICS.read_static_synaptic_data(
+                    post_vertex_slice, n_synapse_types, ff_size, ff_data)
+            frozen_connections["source"] = frozen_rows[
+                frozen_connections["source"]]
+            connections.append(frozen_connections)
+
+        return numpy.concatenate(connections)
+
     def get_block_n_bytes(self, max_row_length, n_rows):
         return ((_N_HEADER_WORDS + max_row_length) * 4) * n_rows
@@ -14,6 +14,10 @@ from spynnaker.pyNN.models.neural_projections.projection_partitionable_edge \
     import ProjectionPartitionableEdge
 from spynnaker.pyNN.models.neuron.synapse_dynamics.synapse_dynamics_static \
     import SynapseDynamicsStatic
+from spynnaker.pyNN.models.neuron.synapse_dynamics\
+    .abstract_plastic_synapse_dynamics import AbstractPlasticSynapseDynamics
+from spynnaker.pyNN.models.neuron.synapse_dynamics\
+    .abstract_synapse_dynamics import AbstractSynapseDynamics
 
 from pacman.model.partitionable_graph.abstract_partitionable_vertex \
     import AbstractPartitionableVertex
@@ -25,8 +29,8 @@ from spinn_front_end_common.utilities import helpful_functions
 
 from scipy import special
 from collections import defaultdict
-from pyNN.random import RandomDistribution
 import math
+import struct
 import sys
 import numpy
 
@@ -36,6 +40,20 @@ _SYNAPSES_BASE_SDRAM_USAGE_IN_BYTES = 0
 _SYNAPSES_BASE_N_CPU_CYCLES_PER_NEURON = 10
 _SYNAPSES_BASE_N_CPU_CYCLES = 8
 
+# The plastic weights region starts with the number of blocks and the number
+# of weights written by the core, followed by the offset in words, number of
+# rows and row length in words of each block
+_PLASTIC_WEIGHTS_HEADER_BYTES = 8
+_PLASTIC_WEIGHTS_BLOCK_BYTES = 12
+
+# Each ring buffer entry is a 16-bit weight
+_RING_BUFFER_ENTRY_BYTES = 2
+
+# The source, target and delay in time steps of each plastic synapse, in the
+# order in which the core writes the weights of the synapses
+_PLASTIC_WEIGHT_ORDER_DTYPE = [
+    ("source", "uint32"), ("target", "uint32"), ("delay", "uint16")]
+
 
 class SynapticManager(object):
     """ Deals with synapses
@@ -71,6 +89,11 @@ class SynapticManager(object):
         if self._spikes_per_second is None:
             self._spikes_per_second = conf.config.getfloat(
                 "Simulation", "spikes_per_second")
+
+        # The most DTCM the ring buffers can use when deepened to support
+        # longer delays without a delay extension
+        self._max_ring_buffer_dtcm_bytes = conf.config.getint(
+            "Simulation", "max_ring_buffer_dtcm_bytes")
         self._spikes_per_tick = max(
             1.0,
             self._spikes_per_second /
@@ -80,11 +103,23 @@ class SynapticManager(object):
         # synapse dynamics per vertex at present
         self._synapse_dynamics = SynapseDynamicsStatic()
 
+        # True if the plastic synapses are to stop learning
+        self._plasticity_frozen = False
+
         # Keep the details once computed to allow reading back
         self._weight_scales = dict()
         self._delay_key_index = dict()
         self._retrieved_blocks = dict()
 
+        # The index of the first of the weights of each plastic subedge in
+        # the plastic weights region and the order of the synapses of the
+        # weights, indexed by placement, subedge and synapse information
+        # index, and the total number of weights in the region of each
+        # placement, used to read the weights written by the cores at the end
+        # of each run
+        self._plastic_weight_order = dict()
+        self._n_plastic_weights = dict()
+
         # A list of connection holders to be filled in pre-run, indexed by
         # the edge the connection is for
         self._pre_run_connection_holders = defaultdict(list)
@@ -134,6 +169,37 @@ class SynapticManager(object):
     def maximum_delay_supported_in_ms(self):
         return self._synapse_io.get_maximum_delay_supported_in_ms()
 
+    def _get_ring_buffer_dtcm_usage_in_bytes(self, n_atoms, delay_bits):
+
+        # The delay slots of each synapse type and neuron are contiguous,
+        # indexed by the synapse type and neuron index of a synaptic word, so
+        # only the last synapse type ends after the last neuron
+        n_synapse_types = self._synapse_type.get_n_synapse_types()
+        n_entries = (
+            (((n_synapse_types - 1) << constants.SYNAPSE_INDEX_BITS) +
+             n_atoms) << delay_bits)
+        return n_entries * _RING_BUFFER_ENTRY_BYTES
+
+    def increase_maximum_delay_supported(self, max_delay, max_atoms_per_core):
+        """ Deepen the ring buffers, if needed, to support delays of up to\
+            max_delay ms without a delay extension, as far as the ring\
+            buffers of a core of max_atoms_per_core neurons stay within the\
+            DTCM allowed for them
+
+        :return: The maximum delay now supported in ms
+        """
+        max_delay_tics = int(math.ceil(
+            max_delay * (1000.0 / self._machine_time_step)))
+        delay_bits = self._synapse_io.ring_buffer_delay_bits
+        while (max_delay_tics > (1 << delay_bits) and
+                delay_bits < constants.SYNAPSE_DELAY_BITS and
+                self._get_ring_buffer_dtcm_usage_in_bytes(
+                    max_atoms_per_core, delay_bits + 1) <=
+                self._max_ring_buffer_dtcm_bytes):
+            delay_bits += 1
+        self._synapse_io.ring_buffer_delay_bits = delay_bits
+        return self._synapse_io.get_maximum_delay_supported_in_ms()
+
     @property
     def vertex_executable_suffix(self):
         return self._synapse_dynamics.get_vertex_executable_suffix()
@@ -150,15 +216,19 @@ class SynapticManager(object):
 
     def get_dtcm_usage_in_bytes(self, vertex_slice, graph):
 
-        # TODO: Calculate this correctly
-        return 0
+        # TODO: Calculate the rest of this correctly
+        return (self._synapse_dynamics.get_dtcm_usage_in_bytes(
+                    vertex_slice.n_atoms) +
+                self._get_ring_buffer_dtcm_usage_in_bytes(
+                    vertex_slice.n_atoms,
+                    self._synapse_io.ring_buffer_delay_bits))
 
     def _get_synapse_params_size(self, vertex_slice):
         per_neuron_usage = (
             self._synapse_type.get_sdram_usage_per_neuron_in_bytes())
         return (_SYNAPSES_BASE_SDRAM_USAGE_IN_BYTES +
                 (per_neuron_usage * vertex_slice.n_atoms) +
-                (4 * self._synapse_type.get_n_synapse_types()))
+                (4 * self._synapse_type.get_n_synapse_types()) + 4)
 
     def _get_exact_synaptic_blocks_size(
             self, post_slices, post_slice_index, post_vertex_slice,
@@ -181,17 +251,20 @@ class SynapticManager(object):
                 pre_slice_index = graph_mapper.get_subvertex_index(
                     subedge.pre_subvertex)
 
-                memory_size += self._get_size_of_synapse_information(
+                blocks_size, _ = self._get_size_of_synapse_information(
                     edge.synapse_information, pre_slices, pre_slice_index,
                     post_slices, post_slice_index, pre_vertex_slice,
                     post_vertex_slice, edge.n_delay_stages)
+                memory_size += blocks_size
 
         return memory_size
 
     def _get_estimate_synaptic_blocks_size(self, post_vertex_slice, in_edges):
-        """ Get an estimate of the synaptic blocks memory size
+        """ Get an estimate of the synaptic blocks memory size, and of the\
+            size of the plastic weights region
         """
         memory_size = 0
+        plastic_weights_size = 0
 
         for in_edge in in_edges:
             if isinstance(in_edge, ProjectionPartitionableEdge):
@@ -227,21 +300,31 @@ class SynapticManager(object):
 
                 pre_slice_index = 0
                 for pre_vertex_slice in pre_slices:
-                    memory_size += self._get_size_of_synapse_information(
-                        in_edge.synapse_information, pre_slices,
-                        pre_slice_index, post_slices, post_slice_index,
-                        pre_vertex_slice, post_vertex_slice,
-                        in_edge.n_delay_stages)
+                    blocks_size, weights_size = \
+                        self._get_size_of_synapse_information(
+                            in_edge.synapse_information, pre_slices,
+                            pre_slice_index, post_slices, post_slice_index,
+                            pre_vertex_slice, post_vertex_slice,
+                            in_edge.n_delay_stages)
+                    memory_size += blocks_size
+                    plastic_weights_size += weights_size
                     pre_slice_index += 1
 
-        return memory_size
+        if plastic_weights_size > 0:
+            plastic_weights_size += _PLASTIC_WEIGHTS_HEADER_BYTES
+        return memory_size, plastic_weights_size
 
     def _get_size_of_synapse_information(
             self, synapse_information, pre_slices, pre_slice_index,
             post_slices, post_slice_index, pre_vertex_slice, post_vertex_slice,
             n_delay_stages):
+        """ Get the size of the synaptic blocks of a list of synapse\
+            information objects, and an upper bound on the space needed for\
+            the plastic weights of the blocks
+        """
 
         memory_size = 0
+        plastic_weights_size = 0
         for synapse_info in synapse_information:
             undelayed_size, delayed_size = \
                 self._synapse_io.get_sdram_usage_in_bytes(
@@ -256,19 +339,36 @@ class SynapticManager(object):
             memory_size = self._population_table_type\
                 .get_next_allowed_address(memory_size)
             memory_size += delayed_size
-        return memory_size
+
+            # Each plastic synapse takes at least 4 bytes of a block and has a
+            # 2 byte weight
+            if isinstance(synapse_info.synapse_dynamics,
+                          AbstractPlasticSynapseDynamics):
+                for size in (undelayed_size, delayed_size):
+                    if size > 0:
+                        plastic_weights_size += (
+                            _PLASTIC_WEIGHTS_BLOCK_BYTES +
+                            int(math.ceil(size / 8.0)) * 4)
+        return memory_size, plastic_weights_size
 
     def _get_synapse_dynamics_parameter_size(self, vertex_slice, in_edges):
         """ Get the size of the synapse dynamics region
         """
-        return self._synapse_dynamics.get_parameters_sdram_usage_in_bytes(
+        size = self._synapse_dynamics.get_parameters_sdram_usage_in_bytes(
             vertex_slice.n_atoms, self._synapse_type.get_n_synapse_types())
 
+        # Plastic parameters are followed by a word which freezes plasticity
+        if isinstance(self._synapse_dynamics, AbstractPlasticSynapseDynamics):
+            size += 4
+        return size
+
     def get_sdram_usage_in_bytes(self, vertex_slice, in_edges):
+        synaptic_blocks_size, plastic_weights_size = \
+            self._get_estimate_synaptic_blocks_size(vertex_slice, in_edges)
         return (
             self._get_synapse_params_size(vertex_slice) +
             self._get_synapse_dynamics_parameter_size(vertex_slice, in_edges) +
-            self._get_estimate_synaptic_blocks_size(vertex_slice, in_edges) +
+            synaptic_blocks_size + plastic_weights_size +
             self._population_table_type.get_master_population_table_size(
                 vertex_slice, in_edges))
 
@@ -305,7 +405,7 @@ class SynapticManager(object):
                 size=synapse_dynamics_sz, label='synapseDynamicsParams')
 
     def get_number_of_mallocs_used_by_dsg(self):
-        return 4
+        return 5
 
     @staticmethod
     def _ring_buffer_expected_upper_bound(
@@ -440,12 +540,7 @@ class SynapticManager(object):
 
                     spikes_per_tick = self._spikes_per_tick
                     if isinstance(edge.pre_vertex, SpikeSourcePoisson):
-                        rate = edge.pre_vertex.rate
-                        if hasattr(rate, "__getitem__"):
-                            rate = max(rate)
-                        elif isinstance(rate, RandomDistribution):
-                            rate = utility_calls.get_maximum_probable_value(
-                                rate, pre_vertex_slice.n_atoms)
+                        rate = edge.pre_vertex.get_max_rate(pre_vertex_slice)
                         if rate > max_rate:
                             max_rate = rate
                         spikes_per_tick = max(
@@ -513,6 +608,7 @@ class SynapticManager(object):
             self._synapse_type.get_synapse_type_parameters())
 
         spec.write_array(ring_buffer_shifts)
+        spec.write_value(data=self._synapse_io.ring_buffer_delay_bits)
 
         weight_scales = numpy.array([
             self._get_weight_scale(r) * weight_scale
@@ -542,9 +638,13 @@ class SynapticManager(object):
             self, spec, post_slices, post_slice_index, subvertex,
             post_vertex_slice, all_syn_block_sz, weight_scales,
             master_pop_table_region, synaptic_matrix_region, routing_info,
-            graph_mapper, partitioned_graph):
+            graph_mapper, partitioned_graph, placement):
         """ Simultaneously generates both the master population table and
             the synaptic matrix.
+
+        :return: The offset in words, number of rows and row length in words\
+            of each block of plastic synapses, and the number of plastic\
+            synapses in the blocks
         """
         spec.comment(
             "\nWriting Synaptic Matrix and Master Population Table:\n")
@@ -553,6 +653,10 @@ class SynapticManager(object):
         next_block_start_address = 0
         n_synapse_types = self._synapse_type.get_n_synapse_types()
 
+        # Track the blocks of plastic synapses
+        plastic_blocks = list()
+        n_plastic_weights = 0
+
         # Get the edges
         in_subedges = \
             partitioned_graph.incoming_subedges_from_subvertex(subvertex)
@@ -595,20 +699,32 @@ class SynapticManager(object):
                         raise Exception("Found delayed source ids but no delay"
                                         " edge for edge {}".format(edge.label))
 
-                    if ((edge, synapse_info) in
-                            self._pre_run_connection_holders):
-                        holders = self._pre_run_connection_holders[
-                            edge, synapse_info]
+                    is_plastic = isinstance(
+                        synapse_info.synapse_dynamics,
+                        AbstractPlasticSynapseDynamics)
+                    holders = self._pre_run_connection_holders.get(
+                        (edge, synapse_info), [])
+                    if is_plastic or len(holders) > 0:
+                        connections = self._synapse_io.read_synapses(
+                            synapse_info, pre_vertex_slice, post_vertex_slice,
+                            row_length, delayed_row_length, n_synapse_types,
+                            weight_scales, row_data, delayed_row_data,
+                            edge.n_delay_stages)
                         for connection_holder in holders:
-                            connections = self._synapse_io.read_synapses(
-                                synapse_info, pre_vertex_slice,
-                                post_vertex_slice, row_length,
-                                delayed_row_length, n_synapse_types,
-                                weight_scales, row_data, delayed_row_data,
-                                edge.n_delay_stages)
                             connection_holder.add_connections(connections)
                             connection_holder.finish()
 
+                        # Keep only the order of the plastic synapses to
+                        # match the weights written back by the core with
+                        if is_plastic:
+                            self._plastic_weight_order[
+                                placement, subedge, synapse_info.index] = (
+                                    n_plastic_weights,
+                                    self._get_plastic_weight_order(
+                                        connections))
+                            n_plastic_weights += len(connections)
+                        del connections
+
                     if len(row_data) > 0:
                         next_block_start_address = self._write_padding(
                             spec, synaptic_matrix_region,
@@ -624,6 +740,11 @@ class SynapticManager(object):
                             .update_master_population_table(
                                 spec, next_block_start_address, row_length,
                                 keys_and_masks, master_pop_table_region)
+                        if is_plastic:
+                            plastic_blocks.append((
+                                next_block_start_address / 4,
+                                len(row_data) / (row_length + 3),
+                                row_length + 3))
                         next_block_start_address += len(row_data) * 4
                     del row_data
 
@@ -647,6 +768,12 @@ class SynapticManager(object):
                                 spec, next_block_start_address,
                                 delayed_row_length, keys_and_masks,
                                 master_pop_table_region)
+                        if is_plastic:
+                            plastic_blocks.append((
+                                next_block_start_address / 4,
+                                len(delayed_row_data) /
+                                (delayed_row_length + 3),
+                                delayed_row_length + 3))
                         next_block_start_address += len(delayed_row_data) * 4
                     del delayed_row_data
 
@@ -658,6 +785,45 @@ class SynapticManager(object):
 
         self._population_table_type.finish_master_pop_table(
             spec, master_pop_table_region)
+        return plastic_blocks, n_plastic_weights
+
+    def _get_plastic_weight_order(self, connections):
+        """ Get the source, target and delay in time steps of each of the\
+            given plastic connections, without their weights
+        """
+        order = numpy.zeros(
+            len(connections), dtype=_PLASTIC_WEIGHT_ORDER_DTYPE)
+        if len(connections) > 0:
+            order["source"] = connections["source"]
+            order["target"] = connections["target"]
+            order["delay"] = numpy.rint(
+                connections["delay"] * (1000.0 / self._machine_time_step))
+        return order
+
+    def _write_plastic_weights_region(
+            self, spec, plastic_weights_region, plastic_blocks,
+            n_plastic_weights):
+        """ Write the blocks of plastic synapses whose weights the core is to\
+            write into the plastic weights region at the end of each run
+        """
+        if len(plastic_blocks) == 0:
+            return
+
+        spec.reserve_memory_region(
+            region=plastic_weights_region,
+            size=(_PLASTIC_WEIGHTS_HEADER_BYTES +
+                  (_PLASTIC_WEIGHTS_BLOCK_BYTES * len(plastic_blocks)) +
+                  (int(math.ceil(n_plastic_weights / 2.0)) * 4)),
+            label='PlasticWeights')
+        spec.switch_write_focus(plastic_weights_region)
+        spec.write_value(data=len(plastic_blocks))
+
+        # The core writes the number of weights when it has written them
+        spec.write_value(data=0)
+        for offset, n_rows, n_row_words in plastic_blocks:
+            spec.write_value(data=offset)
+            spec.write_value(data=n_rows)
+            spec.write_value(data=n_row_words)
 
     def write_data_spec(
             self, spec, vertex, post_vertex_slice, subvertex, placement,
@@ -694,19 +860,69 @@ class SynapticManager(object):
             spec, subvertex, partitioned_graph, graph_mapper, post_slices,
             post_slice_index, post_vertex_slice, input_type)
 
-        self._write_synaptic_matrix_and_master_population_table(
-            spec, post_slices, post_slice_index, subvertex, post_vertex_slice,
-            all_syn_block_sz, weight_scales,
-            constants.POPULATION_BASED_REGIONS.POPULATION_TABLE.value,
-            constants.POPULATION_BASED_REGIONS.SYNAPTIC_MATRIX.value,
-            routing_info, graph_mapper, partitioned_graph)
+        plastic_blocks, n_plastic_weights = \
+            self._write_synaptic_matrix_and_master_population_table(
+                spec, post_slices, post_slice_index, subvertex,
+                post_vertex_slice, all_syn_block_sz, weight_scales,
+                constants.POPULATION_BASED_REGIONS.POPULATION_TABLE.value,
+                constants.POPULATION_BASED_REGIONS.SYNAPTIC_MATRIX.value,
+                routing_info, graph_mapper, partitioned_graph, placement)
+
+        # The size of this region is only known once the synaptic matrix has
+        # been generated
+        self._write_plastic_weights_region(
+            spec, constants.POPULATION_BASED_REGIONS.PLASTIC_WEIGHTS.value,
+            plastic_blocks, n_plastic_weights)
+        self._n_plastic_weights[placement] = n_plastic_weights
 
         self._synapse_dynamics.write_parameters(
             spec, constants.POPULATION_BASED_REGIONS.SYNAPSE_DYNAMICS.value,
             self._machine_time_step, weight_scales)
+        if isinstance(self._synapse_dynamics, AbstractPlasticSynapseDynamics):
+            spec.write_value(data=int(self._plasticity_frozen))
 
         self._weight_scales[placement] = weight_scales
 
+    @property
+    def plasticity_frozen(self):
+        return self._plasticity_frozen
+
+    def freeze_plasticity(
+            self, vertex, transceiver=None, placements=None,
+            graph_mapper=None):
+        """ Stop the plastic synapses of a vertex from learning, so that they\
+            keep the weights they have now.  Each core rewrites its plastic\
+            rows as static rows as they are next used.  If the transceiver is\
+            given, the vertex has already run and the change is written to\
+            the machine, taking effect when the simulation is next resumed\
+            without the synaptic matrix having to be reloaded.
+
+        :param vertex: The vertex that this manager handles the synapses of
+        """
+        if not isinstance(
+                self._synapse_dynamics, AbstractPlasticSynapseDynamics):
+            raise exceptions.SynapticConfigurationException(
+                "{} has no plastic synapses to freeze".format(vertex.label))
+        self._plasticity_frozen = True
+        if transceiver is None:
+            return
+
+        n_synapse_types = self._synapse_type.get_n_synapse_types()
+        for subvertex in graph_mapper.get_subvertices_from_vertex(vertex):
+            placement = placements.get_placement_of_subvertex(subvertex)
+            vertex_slice = graph_mapper.get_subvertex_slice(subvertex)
+
+            # The word follows the plastic parameters in the region
+            address = helpful_functions.locate_memory_region_for_placement(
+                placement,
+                constants.POPULATION_BASED_REGIONS.SYNAPSE_DYNAMICS.value,
+                transceiver)
+            address += self._synapse_dynamics.\
+                get_parameters_sdram_usage_in_bytes(
+                    vertex_slice.n_atoms, n_synapse_types)
+            transceiver.write_memory(
+                placement.x, placement.y, address, struct.pack("<I", 1))
+
     def get_connections_from_machine(
             self, transceiver, placement, subedge, graph_mapper,
             routing_infos, synapse_info, partitioned_graph):
@@ -716,6 +932,13 @@ class SynapticManager(object):
         if not isinstance(edge, ProjectionPartitionableEdge):
             return None
 
+        # Plastic connections can be read from the weights written by the
+        # core at the end of the last run, if it has written them
+        connections = self._read_plastic_weights(
+            transceiver, placement, subedge, synapse_info)
+        if connections is not None:
+            return connections
+
         # Get details for extraction
         pre_vertex_slice = graph_mapper.get_subvertex_slice(
             subedge.pre_subvertex)
@@ -769,6 +992,48 @@ class SynapticManager(object):
             self._weight_scales[placement], data, delayed_data,
             edge.n_delay_stages)
 
+    def _read_plastic_weights(
+            self, transceiver, placement, subedge, synapse_info):
+        """ Read the connections of a plastic subedge using the weights\
+            written by the core into the plastic weights region, or return\
+            None if the weights have not been written since the last run
+        """
+        key = (placement, subedge, synapse_info.index)
+        if key not in self._plastic_weight_order:
+            return None
+        first_weight, order = self._plastic_weight_order[key]
+        connections = numpy.zeros(
+            len(order), dtype=AbstractSynapseDynamics.NUMPY_CONNECTORS_DTYPE)
+        if len(connections) == 0:
+            return connections
+
+        address = helpful_functions.locate_memory_region_for_placement(
+            placement,
+            constants.POPULATION_BASED_REGIONS.PLASTIC_WEIGHTS.value,
+            transceiver)
+        n_blocks, n_weights_written = struct.unpack_from(
+            "<II", transceiver.read_memory(
+                placement.x, placement.y, address,
+                _PLASTIC_WEIGHTS_HEADER_BYTES))
+        if n_weights_written != self._n_plastic_weights[placement]:
+            return None
+
+        # The weights of each block follow the header and the block list
+        weights_address = (
+            address + _PLASTIC_WEIGHTS_HEADER_BYTES +
+            (_PLASTIC_WEIGHTS_BLOCK_BYTES * n_blocks) + (first_weight * 2))
+        weights = numpy.frombuffer(transceiver.read_memory(
+            placement.x, placement.y, weights_address, len(connections) * 2),
+            dtype="<u2")
+        connections["source"] = order["source"]
+        connections["target"] = order["target"]
+        connections["weight"] = (
+            weights / self._weight_scales[placement][
+                synapse_info.synapse_type])
+        connections["delay"] = (
+            order["delay"] / (1000.0 / self._machine_time_step))
+        return connections
+
     def _retrieve_synaptic_block(
             self, transceiver, placement, master_pop_table_address,
             synaptic_matrix_address, key, n_rows, index):
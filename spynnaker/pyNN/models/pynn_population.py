@@ -16,6 +16,10 @@ from spynnaker.pyNN.models.common.abstract_gsyn_recordable \
     import AbstractGSynRecordable
 from spynnaker.pyNN.models.common.abstract_v_recordable \
     import AbstractVRecordable
+from spynnaker.pyNN.models.neuron.abstract_population_vertex \
+    import AbstractPopulationVertex
+from spynnaker.pyNN.models.spike_source.spike_source_poisson \
+    import SpikeSourcePoisson
 
 from spinn_front_end_common.utilities import exceptions
 from spinn_front_end_common.abstract_models.abstract_changable_after_run \
@@ -147,6 +151,55 @@ class Population(object):
         # TODO: Used to get a single cell - not yet supported
         raise NotImplementedError
 
+    def freeze_plasticity(self):
+        """ Stop the plastic synapses into the population from learning, so\
+            that they keep the weights they have now.  If the simulation has\
+            run, the weights learnt so far stay on the machine and are used\
+            as static weights from the next run; the synaptic matrix is not\
+            reloaded.
+        """
+        if not isinstance(self._vertex, AbstractPopulationVertex):
+            raise exceptions.ConfigurationException(
+                "This population does not have synapses")
+
+        if (not self._spinnaker.has_ran or
+                self._spinnaker.use_virtual_board):
+            self._vertex.freeze_plasticity()
+            return
+
+        self._vertex.freeze_plasticity(
+            self._spinnaker.transceiver, self._spinnaker.placements,
+            self._spinnaker.graph_mapper)
+
+    def set_rates(self, rate, neuron_ids=None, wait=False):
+        """ Change the rates of the sources of a Poisson spike source\
+            population.  If the simulation has run, the new rates are sent\
+            to the machine, where each core picks them up at its next timer\
+            tick, without reloading the simulation; this can be done while\
+            the simulation is running, or between runs, in which case the\
+            new rates apply from the start of the next run.
+
+        :param rate: The new rate, or a list of rates, one per neuron id
+        :param neuron_ids: The ids of the sources to change, or None for all
+        :param wait: Whether to wait for the machine to acknowledge the new\
+            rates; only pass True while the simulation is running, as a\
+            paused simulation picks them up when it is next run
+        """
+        if not isinstance(self._vertex, SpikeSourcePoisson):
+            raise exceptions.ConfigurationException(
+                "This population is not a Poisson spike source")
+        if neuron_ids is None:
+            neuron_ids = range(self._size)
+
+        if (not self._spinnaker.has_ran or
+                self._spinnaker.use_virtual_board):
+            self._vertex.set_rates(rate, neuron_ids)
+            return
+
+        self._vertex.update_rates_on_machine(
+            rate, neuron_ids, self._spinnaker.transceiver,
+            self._spinnaker.placements, self._spinnaker.graph_mapper, wait)
+
     def get(self, parameter_name, gather=False):
         """ Get the values of a parameter for every local cell in the\
             population.
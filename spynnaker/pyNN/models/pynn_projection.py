@@ -91,8 +91,19 @@ class Projection(object):
         delay_extension_max_supported_delay = (
             constants.MAX_DELAY_BLOCKS *
             constants.MAX_TIMER_TICS_SUPPORTED_PER_BLOCK)
+        post_vertex = postsynaptic_population._get_vertex
         post_vertex_max_supported_delay_ms = \
-            postsynaptic_population._get_vertex.maximum_delay_supported_in_ms
+            post_vertex.maximum_delay_supported_in_ms
+
+        # if the post vertex can support longer delays itself, ask it to, so
+        # that a delay extension is only used when it cannot; once the
+        # simulation has run, delay extensions may already have been added
+        # for the delays it does not support, so these are left as they are
+        if (max_delay > post_vertex_max_supported_delay_ms and
+                not spinnaker_control.has_ran and
+                hasattr(post_vertex, "increase_maximum_delay_supported")):
+            post_vertex_max_supported_delay_ms = \
+                post_vertex.increase_maximum_delay_supported(max_delay)
 
         if max_delay > (post_vertex_max_supported_delay_ms +
                         delay_extension_max_supported_delay):
@@ -132,13 +143,15 @@ class Projection(object):
             spinnaker_control.add_partitionable_edge(
                 self._projection_edge, EDGE_PARTITION_ID)
 
-        # If the delay exceeds the post vertex delay, add a delay extension
-        if max_delay > post_vertex_max_supported_delay_ms:
-            delay_edge = self._add_delay_extension(
-                presynaptic_population, postsynaptic_population, max_delay,
-                post_vertex_max_supported_delay_ms, machine_time_step,
-                timescale_factor)
-            self._projection_edge.delay_edge = delay_edge
+        # If the delay exceeds the post vertex delay, a delay extension is
+        # added when the simulation is next mapped, as later projections may
+        # yet increase the delay the post vertex supports
+        self._presynaptic_population = presynaptic_population
+        self._postsynaptic_population = postsynaptic_population
+        self._max_delay = max_delay
+        self._machine_time_step = machine_time_step
+        self._timescale_factor = timescale_factor
+        self._delay_extension_checked = False
         spinnaker_control._add_projection(self)
 
         # If there is a virtual board, we need to hold the data in case the
@@ -188,6 +201,26 @@ class Projection(object):
                 return edge
         return None
 
+    def _add_delay_extension_if_needed(self):
+        """ Add a delay extension for the delays of the projection that the\
+            post vertex does not support; this is done once, before the\
+            simulation is first mapped with the projection, when the delays\
+            the post vertex supports are final
+        """
+        if self._delay_extension_checked:
+            return
+        self._delay_extension_checked = True
+
+        post_vertex_max_supported_delay_ms = \
+            self._postsynaptic_population._get_vertex\
+            .maximum_delay_supported_in_ms
+        if self._max_delay > post_vertex_max_supported_delay_ms:
+            delay_edge = self._add_delay_extension(
+                self._presynaptic_population, self._postsynaptic_population,
+                self._max_delay, post_vertex_max_supported_delay_ms,
+                self._machine_time_step, self._timescale_factor)
+            self._projection_edge.delay_edge = delay_edge
+
     def _add_delay_extension(
             self, presynaptic_population, postsynaptic_population,
             max_delay_for_projection, max_delay_per_neuron, machine_time_step,
@@ -195,13 +228,19 @@ class Projection(object):
         """ Instantiate delay extension component
         """
 
+        # Each stage of a delay extension delays by a fixed number of time
+        # steps, however long the delays supported by the post vertex are
+        delay_stage_length = (
+            constants.MAX_TIMER_TICS_SUPPORTED_PER_BLOCK *
+            (machine_time_step / 1000.0))
+
         # Create a delay extension vertex to do the extra delays
         delay_vertex = presynaptic_population._internal_delay_vertex
         pre_vertex = presynaptic_population._get_vertex
         if delay_vertex is None:
             delay_name = "{}_delayed".format(pre_vertex.label)
             delay_vertex = DelayExtensionVertex(
-                pre_vertex.n_atoms, max_delay_per_neuron, pre_vertex,
+                pre_vertex.n_atoms, delay_stage_length, pre_vertex,
                 machine_time_step, timescale_factor, label=delay_name)
             presynaptic_population._internal_delay_vertex = delay_vertex
             pre_vertex.add_constraint(
@@ -218,7 +257,7 @@ class Projection(object):
         # Ensure that the delay extension knows how many states it will support
         n_stages = int(math.ceil(
             float(max_delay_for_projection - max_delay_per_neuron) /
-            float(max_delay_per_neuron)))
+            delay_stage_length))
         if n_stages > delay_vertex.n_delay_stages:
             delay_vertex.n_delay_stages = n_stages
 
@@ -30,10 +30,116 @@ from spinn_front_end_common.utility_models\
 
 # general imports
 import logging
+import math
+import numpy
 import sys
 
 logger = logging.getLogger(__name__)
 
+# Each value in a compressed spike stream is held in one or more halfwords,
+# 15 bits in each, least significant first, with the top bit set in all but
+# the last halfword
+_STREAM_VALUE_BITS = 15
+_STREAM_VALUE_MASK = (1 << _STREAM_VALUE_BITS) - 1
+_STREAM_CONTINUE_BIT = 1 << _STREAM_VALUE_BITS
+
+
+def _append_stream_value(stream, value):
+    """ Append a value to a compressed spike stream
+    """
+    while value > _STREAM_VALUE_MASK:
+        stream.append((value & _STREAM_VALUE_MASK) | _STREAM_CONTINUE_BIT)
+        value >>= _STREAM_VALUE_BITS
+    stream.append(value)
+
+
+def _get_stream_values(spikes):
+    """ Get the values of a compressed spike stream, in order
+
+    :param spikes: A sorted list of (time step, index of the source)
+    """
+    last_tick = 0
+    position = 0
+    while position < len(spikes):
+        tick = spikes[position][0]
+        end = position
+        while end < len(spikes) and spikes[end][0] == tick:
+            end += 1
+        yield tick - last_tick
+        yield end - position
+        last_index = 0
+        for (_, index) in spikes[position:end]:
+            yield index - last_index
+            last_index = index
+        last_tick = tick
+        position = end
+
+
+def get_spike_ticks(spike_times, vertex_slice, machine_time_step):
+    """ Get the time steps of the spikes of the sources of a slice, as\
+        played back on the machine
+
+    :param spike_times: The spike times in milliseconds, either as a list for\
+        each source or as a single list for all the sources
+    :param vertex_slice: The slice of the sources
+    :param machine_time_step: The time step in microseconds
+    :return: A sorted list of (time step, index of the source in the slice);\
+        spikes before time step 0 are left out
+    """
+    per_source = (len(spike_times) > 0 and
+                  hasattr(spike_times[0], "__len__"))
+    spikes = list()
+    for index in range(vertex_slice.n_atoms):
+        if per_source:
+            times = spike_times[vertex_slice.lo_atom + index]
+        else:
+            times = spike_times
+        for spike_time in times:
+            tick = int(math.ceil((spike_time * 1000.0) / machine_time_step))
+            if tick >= 0:
+                spikes.append((tick, index))
+    spikes.sort()
+    return spikes
+
+
+def compress_spike_times(spike_times, vertex_slice, machine_time_step):
+    """ Compress the spikes of the sources of a slice into the stream read\
+        by the spike source array binary.  There is a block for each time\
+        step with spikes, being the number of time steps since the last\
+        block (or since time step 0), the number of spikes and then the\
+        index of each spiking source in the slice, as the difference from\
+        the previous index in the block (or from 0).
+
+    :param spike_times: The spike times in milliseconds, either as a list for\
+        each source or as a single list for all the sources
+    :param vertex_slice: The slice of the sources
+    :param machine_time_step: The time step in microseconds
+    :return: The stream, as an array of 16-bit halfwords
+    """
+    stream = list()
+    for value in _get_stream_values(
+            get_spike_ticks(spike_times, vertex_slice, machine_time_step)):
+        _append_stream_value(stream, value)
+    return numpy.array(stream, dtype="uint16")
+
+
+def get_compressed_spike_times_size(
+        spike_times, vertex_slice, machine_time_step):
+    """ Get the number of halfwords in the compressed stream of the spikes\
+        of the sources of a slice, without building the stream
+
+    :param spike_times: The spike times in milliseconds, either as a list for\
+        each source or as a single list for all the sources
+    :param vertex_slice: The slice of the sources
+    :param machine_time_step: The time step in microseconds
+    :return: The number of halfwords
+    """
+    return sum(
+        max(1, int(math.ceil(value.bit_length() /
+                             float(_STREAM_VALUE_BITS))))
+        for value in _get_stream_values(
+            get_spike_ticks(spike_times, vertex_slice, machine_time_step)))
+
 
 class SpikeSourceArray(
         ReverseIpTagMultiCastSource, AbstractSpikeRecordable,
@@ -63,6 +169,11 @@ class SpikeSourceArray(
             self._port = config.getint("Buffers", "receive_buffer_port")
         if spike_times is None:
             spike_times = []
+        if config.getint("Simulation", "timesteps_per_timer_tick") != 1:
+            raise exceptions.ConfigurationException(
+                "SpikeSourceArray does not support running more than one "
+                "time step per timer tick; please set "
+                "timesteps_per_timer_tick to 1")
         self._minimum_sdram_for_buffering = config.getint(
             "Buffers", "minimum_buffer_sdram")
         self._using_auto_pause_and_resume = config.getboolean(
@@ -0,0 +1,405 @@
+from pacman.model.partitionable_graph.abstract_partitionable_vertex \
+    import AbstractPartitionableVertex
+from pacman.model.constraints.key_allocator_constraints\
+    .key_allocator_contiguous_range_constraint \
+    import KeyAllocatorContiguousRangeContraint
+
+from spynnaker.pyNN.models.common.abstract_spike_recordable \
+    import AbstractSpikeRecordable
+from spynnaker.pyNN.models.common.population_settable_change_requires_mapping \
+    import PopulationSettableChangeRequiresMapping
+from spynnaker.pyNN.models.common.spike_recorder import SpikeRecorder
+from spynnaker.pyNN.utilities.conf import config
+from spynnaker.pyNN.models.common import recording_utils
+from spynnaker.pyNN.models.spike_source.spike_source_array \
+    import compress_spike_times, get_compressed_spike_times_size
+from spynnaker.pyNN.models.spike_source\
+    .spike_source_array_on_chip_partitioned_vertex \
+    import SpikeSourceArrayOnChipPartitionedVertex
+
+from spinn_front_end_common.abstract_models.abstract_data_specable_vertex\
+    import AbstractDataSpecableVertex
+from spinn_front_end_common.abstract_models.\
+    abstract_provides_outgoing_partition_constraints import \
+    AbstractProvidesOutgoingPartitionConstraints
+from spinn_front_end_common.utilities import constants as\
+    front_end_common_constants
+from spinn_front_end_common.utilities import exceptions
+from spinn_front_end_common.interface.buffer_management.buffer_models\
+    .receives_buffers_to_host_basic_impl import ReceiveBuffersToHostBasicImpl
+
+from data_specification.data_specification_generator\
+    import DataSpecificationGenerator
+
+import numpy
+import logging
+
+logger = logging.getLogger(__name__)
+
+PARAMS_WORDS = 3
+
+# The spike data region has the number of halfwords in the stream of spikes,
+# followed by the stream, packed into words
+SPIKE_DATA_HEADER_WORDS = 1
+
+
+def _get_spike_data_bytes(n_halfwords):
+    """ Get the size of the spike data region in bytes for a stream of spikes\
+        with a given number of halfwords
+    """
+    return (SPIKE_DATA_HEADER_WORDS + ((n_halfwords + 1) // 2)) * 4
+
+
+class SpikeSourceArrayOnChip(
+        AbstractPartitionableVertex,
+        AbstractDataSpecableVertex, AbstractSpikeRecordable,
+        AbstractProvidesOutgoingPartitionConstraints,
+        PopulationSettableChangeRequiresMapping):
+    """ Model for play back of spikes which are all loaded on to the machine\
+        before the simulation runs, rather than being sent by the host while\
+        it runs.  The spikes of each core are compressed into a stream which\
+        is read from SDRAM as the simulation runs; the stream of each core\
+        must fit in the SDRAM of its chip, so a population with many spikes\
+        is spread over more cores.
+    """
+
+    _N_POPULATION_RECORDING_REGIONS = 1
+    _DEFAULT_MALLOCS_USED = 4
+
+    _model_based_max_atoms_per_core = 500
+
+    def __init__(
+            self, n_neurons, machine_time_step, timescale_factor,
+            spike_times=None, constraints=None,
+            label="SpikeSourceArrayOnChip"):
+        AbstractPartitionableVertex.__init__(
+            self, n_neurons, label, self._model_based_max_atoms_per_core,
+            constraints)
+        AbstractDataSpecableVertex.__init__(
+            self, machine_time_step=machine_time_step,
+            timescale_factor=timescale_factor)
+        AbstractSpikeRecordable.__init__(self)
+        AbstractProvidesOutgoingPartitionConstraints.__init__(self)
+        PopulationSettableChangeRequiresMapping.__init__(self)
+
+        if spike_times is None:
+            spike_times = []
+        if config.getint("Simulation", "timesteps_per_timer_tick") != 1:
+            raise exceptions.ConfigurationException(
+                "SpikeSourceArrayOnChip does not support running more than "
+                "one time step per timer tick; please set "
+                "timesteps_per_timer_tick to 1")
+        self._spike_times = spike_times
+
+        # Prepare for recording, and to get spikes
+        self._spike_recorder = SpikeRecorder(machine_time_step)
+        self._spike_buffer_max_size = config.getint(
+            "Buffers", "spike_buffer_size")
+        self._buffer_size_before_receive = config.getint(
+            "Buffers", "buffer_size_before_receive")
+        self._time_between_requests = config.getint(
+            "Buffers", "time_between_requests")
+        self._enable_buffered_recording = config.getboolean(
+            "Buffers", "enable_buffered_recording")
+        self._receive_buffer_host = config.get(
+            "Buffers", "receive_buffer_host")
+        self._receive_buffer_port = config.getint(
+            "Buffers", "receive_buffer_port")
+        self._minimum_buffer_sdram = config.getint(
+            "Buffers", "minimum_buffer_sdram")
+        self._using_auto_pause_and_resume = config.getboolean(
+            "Buffers", "use_auto_pause_and_resume")
+
+    def create_subvertex(
+            self, vertex_slice, resources_required, label=None,
+            constraints=None):
+        subvertex = SpikeSourceArrayOnChipPartitionedVertex(
+            resources_required, label, self._spike_recorder.record,
+            constraints)
+        if not self._using_auto_pause_and_resume:
+            spike_buffer_size = self._spike_recorder.get_sdram_usage_in_bytes(
+                vertex_slice.n_atoms, self._no_machine_time_steps)
+            spike_buffering_needed = recording_utils.needs_buffering(
+                self._spike_buffer_max_size, spike_buffer_size,
+                self._enable_buffered_recording)
+            if spike_buffering_needed:
+                subvertex.activate_buffering_output(
+                    buffering_ip_address=self._receive_buffer_host,
+                    buffering_port=self._receive_buffer_port)
+        else:
+            sdram_per_ts = self._spike_recorder.get_sdram_usage_in_bytes(
+                vertex_slice.n_atoms, 1)
+            subvertex.activate_buffering_output(
+                minimum_sdram_for_buffering=self._minimum_buffer_sdram,
+                buffered_sdram_per_timestep=sdram_per_ts)
+
+        return subvertex
+
+    @property
+    def spike_times(self):
+        """ The spike times of the spike source array
+        """
+        return self._spike_times
+
+    @spike_times.setter
+    def spike_times(self, spike_times):
+        """ Set the spike source array's spike times. Not an extend, but an\
+            actual change
+        """
+        self._spike_times = spike_times
+
+    @property
+    def model_name(self):
+        """ Return a string representing a label for this class.
+        """
+        return "SpikeSourceArrayOnChip"
+
+    @staticmethod
+    def set_model_max_atoms_per_core(new_value):
+        SpikeSourceArrayOnChip._model_based_max_atoms_per_core = new_value
+
+    def get_spike_data_bytes(self, vertex_slice):
+        """ Gets the size of the spike data region in bytes; the stream is\
+            only sized here, as the partitioner tries many slices, and is\
+            built when the data is written
+
+        :param vertex_slice:
+        """
+        return _get_spike_data_bytes(get_compressed_spike_times_size(
+            self._spike_times, vertex_slice, self._machine_time_step))
+
+    def reserve_memory_regions(
+            self, spec, setup_sz, params_sz, spike_hist_buff_sz,
+            spike_data_sz, subvertex):
+        """ Reserve memory regions for spike source array parameters, spike\
+            data and output buffer.
+        :param spec:
+        :param setup_sz:
+        :param params_sz:
+        :param spike_hist_buff_sz:
+        :param spike_data_sz:
+        :return:
+        """
+        spec.comment("\nReserving memory space for data regions:\n\n")
+
+        # Reserve memory:
+        spec.reserve_memory_region(
+            region=(
+                SpikeSourceArrayOnChipPartitionedVertex.
+                _SPIKE_SOURCE_ARRAY_REGIONS.SYSTEM_REGION.value),
+            size=setup_sz, label='setup')
+        spec.reserve_memory_region(
+            region=(
+                SpikeSourceArrayOnChipPartitionedVertex.
+                _SPIKE_SOURCE_ARRAY_REGIONS.
+                SPIKE_SOURCE_ARRAY_PARAMS_REGION.value),
+            size=params_sz, label='SpikeSourceArrayParams')
+        subvertex.reserve_buffer_regions(
+            spec,
+            (SpikeSourceArrayOnChipPartitionedVertex.
+                _SPIKE_SOURCE_ARRAY_REGIONS.BUFFERING_OUT_STATE.value),
+            [SpikeSourceArrayOnChipPartitionedVertex.
+                _SPIKE_SOURCE_ARRAY_REGIONS.SPIKE_HISTORY_REGION.value],
+            [spike_hist_buff_sz])
+        subvertex.reserve_provenance_data_region(spec)
+        spec.reserve_memory_region(
+            region=(
+                SpikeSourceArrayOnChipPartitionedVertex.
+                _SPIKE_SOURCE_ARRAY_REGIONS.SPIKE_DATA_REGION.value),
+            size=spike_data_sz, label='SpikeData')
+
+    def _write_setup_info(
+            self, spec, spike_history_region_sz, ip_tags,
+            buffer_size_before_receive, subvertex):
+        """ Write information used to control the simulation and gathering of\
+            results.
+
+        :param spec:
+        :param spike_history_region_sz:
+        :param ip_tags:
+        :return:
+        """
+        self._write_basic_setup_info(
+            spec,
+            (SpikeSourceArrayOnChipPartitionedVertex.
+                _SPIKE_SOURCE_ARRAY_REGIONS.SYSTEM_REGION.value))
+        subvertex.write_recording_data(
+            spec, ip_tags, [spike_history_region_sz],
+            buffer_size_before_receive, self._time_between_requests)
+
+    def _write_spike_source_array_parameters(self, spec, key, vertex_slice):
+        """ Write the parameters of the spike source array
+
+        :param spec:
+        :param key:
+        :param vertex_slice:
+        :return:
+        """
+        spec.comment("\nWriting Parameters for {} spike sources:\n"
+                     .format(vertex_slice.n_atoms))
+        spec.switch_write_focus(
+            region=(
+                SpikeSourceArrayOnChipPartitionedVertex.
+                _SPIKE_SOURCE_ARRAY_REGIONS.
+                SPIKE_SOURCE_ARRAY_PARAMS_REGION.value))
+
+        # Write Key info for this core:
+        if key is None:
+
+            # if there's no key, then two false will cover it.
+            spec.write_value(data=0)
+            spec.write_value(data=0)
+        else:
+
+            # has a key, thus set has key to 1 and then add key
+            spec.write_value(data=1)
+            spec.write_value(data=key)
+
+        spec.write_value(data=vertex_slice.n_atoms)
+
+    def _write_spike_data(self, spec, stream):
+        """ Write the compressed stream of spikes of a slice
+
+        :param spec:
+        :param stream: The stream, as an array of 16-bit halfwords
+        :return:
+        """
+        spec.comment("\nWriting {} halfwords of spike data:\n"
+                     .format(len(stream)))
+        spec.switch_write_focus(
+            region=(
+                SpikeSourceArrayOnChipPartitionedVertex.
+                _SPIKE_SOURCE_ARRAY_REGIONS.SPIKE_DATA_REGION.value))
+        spec.write_value(data=len(stream))
+        if len(stream) > 0:
+            padded = numpy.zeros(
+                ((len(stream) + 1) // 2) * 2, dtype="uint16")
+            padded[:len(stream)] = stream
+            spec.write_array(padded.view("<u4"))
+
+    # @implements AbstractSpikeRecordable.is_recording_spikes
+    def is_recording_spikes(self):
+        return self._spike_recorder.record
+
+    # @implements AbstractSpikeRecordable.set_recording_spikes
+    def set_recording_spikes(self):
+        self._spike_recorder.record = True
+
+    # inherited from partitionable vertex
+    def get_sdram_usage_for_atoms(self, vertex_slice, graph):
+        total_size = \
+            ((front_end_common_constants.
+              DATA_SPECABLE_BASIC_SETUP_INFO_N_WORDS * 4) +
+             ReceiveBuffersToHostBasicImpl.get_recording_data_size(1) +
+             ReceiveBuffersToHostBasicImpl.get_buffer_state_region_size(1) +
+             SpikeSourceArrayOnChipPartitionedVertex.get_provenance_data_size(
+                 SpikeSourceArrayOnChipPartitionedVertex.
+                 N_ADDITIONAL_PROVENANCE_DATA_ITEMS) +
+             (PARAMS_WORDS * 4) + self.get_spike_data_bytes(vertex_slice))
+        total_size += self._get_number_of_mallocs_used_by_dsg(
+            vertex_slice, graph.incoming_edges_to_vertex(self)) * \
+            front_end_common_constants.SARK_PER_MALLOC_SDRAM_USAGE
+
+        if self._using_auto_pause_and_resume:
+            total_size += self._minimum_buffer_sdram
+        else:
+            spike_buffer_size = self._spike_recorder.get_sdram_usage_in_bytes(
+                vertex_slice.n_atoms, self._no_machine_time_steps)
+            total_size += recording_utils.get_buffer_sizes(
+                self._spike_buffer_max_size, spike_buffer_size,
+                self._enable_buffered_recording)
+
+        return total_size
+
+    def _get_number_of_mallocs_used_by_dsg(self, vertex_slice, in_edges):
+        standard_mallocs = self._DEFAULT_MALLOCS_USED
+        if self._spike_recorder.record:
+            standard_mallocs += 1
+        return standard_mallocs
+
+    def get_dtcm_usage_for_atoms(self, vertex_slice, graph):
+        return 0
+
+    def get_cpu_usage_for_atoms(self, vertex_slice, graph):
+        return 0
+
+    def generate_data_spec(
+            self, subvertex, placement, partitioned_graph, graph, routing_info,
+            hostname, graph_mapper, report_folder, ip_tags, reverse_ip_tags,
+            write_text_specs, application_run_time_folder):
+        data_writer, report_writer = \
+            self.get_data_spec_file_writers(
+                placement.x, placement.y, placement.p, hostname, report_folder,
+                write_text_specs, application_run_time_folder)
+
+        spec = DataSpecificationGenerator(data_writer, report_writer)
+
+        vertex_slice = graph_mapper.get_subvertex_slice(subvertex)
+
+        spike_buffer_size = self._spike_recorder.get_sdram_usage_in_bytes(
+            vertex_slice.n_atoms, self._no_machine_time_steps)
+        spike_history_sz = recording_utils.get_buffer_sizes(
+            self._spike_buffer_max_size, spike_buffer_size,
+            self._enable_buffered_recording)
+        spike_buffering_needed = recording_utils.needs_buffering(
+            self._spike_buffer_max_size, spike_buffer_size,
+            self._enable_buffered_recording)
+        buffer_size_before_receive = self._buffer_size_before_receive
+        if not spike_buffering_needed:
+            buffer_size_before_receive = spike_history_sz + 256
+
+        spec.comment(
+            "\n*** Spec for SpikeSourceArrayOnChip Instance ***\n\n")
+
+        # Basic setup plus 8 bytes for recording flags and recording size
+        setup_sz = ((front_end_common_constants.
+                     DATA_SPECABLE_BASIC_SETUP_INFO_N_WORDS * 4) +
+                    subvertex.get_recording_data_size(1))
+
+        stream = compress_spike_times(
+            self._spike_times, vertex_slice, self._machine_time_step)
+
+        # Reserve SDRAM space for memory areas:
+        self.reserve_memory_regions(
+            spec, setup_sz, PARAMS_WORDS * 4, spike_history_sz,
+            _get_spike_data_bytes(len(stream)), subvertex)
+
+        self._write_setup_info(
+            spec, spike_history_sz, ip_tags, buffer_size_before_receive,
+            subvertex)
+
+        # Every subedge should have the same key
+        key = None
+        partitions = partitioned_graph.\
+            outgoing_edges_partitions_from_vertex(subvertex)
+        for partition in partitions.values():
+            keys_and_masks = \
+                routing_info.get_keys_and_masks_from_partition(partition)
+            key = keys_and_masks[0].key
+
+        self._write_spike_source_array_parameters(spec, key, vertex_slice)
+        self._write_spike_data(spec, stream)
+
+        # End-of-Spec:
+        spec.end_specification()
+        data_writer.close()
+
+        return data_writer.filename
+
+    def get_binary_file_name(self):
+        return "spike_source_array.aplx"
+
+    def get_spikes(self, placements, graph_mapper, buffer_manager):
+        return self._spike_recorder.get_spikes(
+            self._label, buffer_manager,
+            (SpikeSourceArrayOnChipPartitionedVertex.
+                _SPIKE_SOURCE_ARRAY_REGIONS.SPIKE_HISTORY_REGION.value),
+            (SpikeSourceArrayOnChipPartitionedVertex.
+                _SPIKE_SOURCE_ARRAY_REGIONS.BUFFERING_OUT_STATE.value),
+            placements, graph_mapper, self)
+
+    def get_outgoing_partition_constraints(self, partition, graph_mapper):
+        return [KeyAllocatorContiguousRangeContraint()]
+
+    def is_data_specable(self):
+        return True
@@ -0,0 +1,72 @@
+from pacman.model.partitioned_graph.partitioned_vertex import PartitionedVertex
+from spinn_front_end_common.interface.buffer_management\
+    .buffer_models.receives_buffers_to_host_basic_impl \
+    import ReceiveBuffersToHostBasicImpl
+from spinn_front_end_common.abstract_models.abstract_recordable \
+    import AbstractRecordable
+from spinn_front_end_common.interface.provenance\
+    .provides_provenance_data_from_machine_impl \
+    import ProvidesProvenanceDataFromMachineImpl
+from spinn_front_end_common.utilities.utility_objs\
+    .provenance_data_item import ProvenanceDataItem
+
+from enum import Enum
+
+
+class SpikeSourceArrayOnChipPartitionedVertex(
+        PartitionedVertex, ReceiveBuffersToHostBasicImpl,
+        ProvidesProvenanceDataFromMachineImpl, AbstractRecordable):
+
+    _SPIKE_SOURCE_ARRAY_REGIONS = Enum(
+        value="_SPIKE_SOURCE_ARRAY_REGIONS",
+        names=[('SYSTEM_REGION', 0),
+               ('SPIKE_SOURCE_ARRAY_PARAMS_REGION', 1),
+               ('SPIKE_HISTORY_REGION', 2),
+               ('BUFFERING_OUT_STATE', 3),
+               ('PROVENANCE_REGION', 4),
+               ('SPIKE_DATA_REGION', 5)])
+
+    # entries for the provenance data generated by the spike source array
+    EXTRA_PROVENANCE_DATA_ENTRIES = Enum(
+        value="EXTRA_PROVENANCE_DATA_ENTRIES",
+        names=[("CHUNKS_PREFETCHED", 0),
+               ("DIRECT_STREAM_READS", 1)])
+
+    N_ADDITIONAL_PROVENANCE_DATA_ITEMS = 2
+
+    def __init__(
+            self, resources_required, label, is_recording, constraints=None):
+        PartitionedVertex.__init__(
+            self, resources_required, label, constraints=constraints)
+        ReceiveBuffersToHostBasicImpl.__init__(self)
+        ProvidesProvenanceDataFromMachineImpl.__init__(
+            self, self._SPIKE_SOURCE_ARRAY_REGIONS.PROVENANCE_REGION.value,
+            self.N_ADDITIONAL_PROVENANCE_DATA_ITEMS)
+        AbstractRecordable.__init__(self)
+        self._is_recording = is_recording
+
+    def is_recording(self):
+        return self._is_recording
+
+    def get_provenance_data_from_machine(self, transceiver, placement):
+        provenance_data = self._read_provenance_data(transceiver, placement)
+        provenance_items = self._read_basic_provenance_items(
+            provenance_data, placement)
+        provenance_data = self._get_remaining_provenance_data_items(
+            provenance_data)
+
+        n_chunks_prefetched = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.CHUNKS_PREFETCHED.value]
+        n_direct_stream_reads = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.DIRECT_STREAM_READS.value]
+
+        label, x, y, p, names = self._get_placement_details(placement)
+
+        # translate into provenance data items
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Spike_data_chunks_prefetched"),
+            n_chunks_prefetched))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Spike_data_words_read_from_SDRAM"),
+            n_direct_stream_reads))
+        return provenance_items
@@ -12,10 +12,12 @@ from spynnaker.pyNN.models.common.population_settable_change_requires_mapping \
     import PopulationSettableChangeRequiresMapping
 from spynnaker.pyNN.models.common.spike_recorder import SpikeRecorder
 from spynnaker.pyNN.utilities.conf import config
+from spynnaker.pyNN.utilities import utility_calls
 from spynnaker.pyNN.models.common import recording_utils
 from spynnaker.pyNN.models.spike_source\
     .spike_source_poisson_partitioned_vertex \
     import SpikeSourcePoissonPartitionedVertex
+from spynnaker.pyNN import exceptions
 
 
 from spinn_front_end_common.abstract_models.abstract_data_specable_vertex\
@@ -25,6 +27,7 @@ from spinn_front_end_common.abstract_models.\
     AbstractProvidesOutgoingPartitionConstraints
 from spinn_front_end_common.utilities import constants as\
     front_end_common_constants
+from spinn_front_end_common.utilities import helpful_functions
 from spinn_front_end_common.interface.buffer_management.buffer_models\
     .receives_buffers_to_host_basic_impl import ReceiveBuffersToHostBasicImpl
 
@@ -32,19 +35,106 @@ from data_specification.data_specification_generator\
     import DataSpecificationGenerator
 from data_specification.enums.data_type import DataType
 
+from pyNN.random import RandomDistribution
 from enum import Enum
 import math
 import numpy
 import logging
-import random
+import struct
+import time
 
 logger = logging.getLogger(__name__)
 
 SLOW_RATE_PER_TICK_CUTOFF = 1.0
-PARAMS_BASE_WORDS = 6
+PARAMS_BASE_WORDS = 7
 PARAMS_WORDS_PER_NEURON = 5
 RANDOM_SEED_WORDS = 4
 
+# The rate update region has a sequence number written by the host, the
+# sequence number acknowledged by the core and the number of updates, then up
+# to one update per source, each being the first source, the number of
+# sources, the mean inter-spike interval, lambda and exp(-lambda)
+RATE_UPDATE_HEADER_WORDS = 3
+RATE_UPDATE_WORDS = 5
+
+# The rate schedule region has the number of scheduled rate changes, then the
+# changes in order of time step, each being the time step followed by an update
+# as above
+RATE_SCHEDULE_HEADER_WORDS = 1
+RATE_SCHEDULE_WORDS = 1 + RATE_UPDATE_WORDS
+
+# How long to wait for a core to acknowledge a rate update, as a number of
+# timer ticks on top of a fixed time in seconds
+_RATE_UPDATE_ACK_TIMEOUT_TICKS = 10
+_RATE_UPDATE_ACK_TIMEOUT = 0.5
+
+# The fast rate region has the number of fast rates and the number of words
+# they take, then each rate in order of lambda, being the method of drawing
+# the number of spikes, lambda, sqrt(lambda) and the number of entries in the
+# table of the cumulative distribution, followed by the table
+FAST_RATE_HEADER_WORDS = 2
+FAST_RATE_WORDS = 4
+
+# The sizes of the structures that the binary allocates in DTCM for each
+# source, being a slow source, a fast source and an entry in the queue of slow
+# spikes
+_SLOW_SOURCE_DTCM_WORDS = 5
+_FAST_SOURCE_DTCM_WORDS = 6
+_SLOW_SPIKE_EVENT_DTCM_WORDS = 2
+
+# The methods of drawing the number of spikes of a fast source
+_FAST_RATE_MULTIPLY = 0
+_FAST_RATE_INVERSE_CDF = 1
+_FAST_RATE_NORMAL = 2
+
+# The shortest time in microseconds of each of the slots of a timer tick over
+# which the spikes of a core are spread
+_MIN_SEND_SLOT_US = 50
+
+# The scales of the fixed point values in the rate updates
+_S1615_SCALE = float(1 << 15)
+_U032_SCALE = float(1 << 32)
+
+
+def _u032_word(value):
+    """ Convert a value in [0, 1] to an unsigned long fract as written to\
+        the machine
+    """
+    return min(int(round(value * _U032_SCALE)), 0xFFFFFFFF)
+
+
+def _s1615_word(value):
+    """ Convert a value to an accum as written to the machine; fast rates\
+        are found on the machine by this value of lambda
+    """
+    return int(round(value * _S1615_SCALE))
+
+
+def get_poisson_cdf_table(lambda_val, max_entries):
+    """ Get the table of the cumulative distribution of a Poisson variate\
+        searched by a fast source using the inverse CDF method.  Entry k is\
+        P(X <= k) scaled to 2^32, and the last entry, which takes the\
+        probability of all larger values, is the first after which less than\
+        2^-32 of the probability remains; each value is therefore drawn with\
+        its probability to within 2^-32.
+
+    :param lambda_val: The mean number of spikes per time step
+    :param max_entries: The most entries the table may have
+    :return: The table, as a list of 32-bit unsigned integers, or None if it\
+        would have more than max_entries entries
+    """
+    table = list()
+    probability = math.exp(-lambda_val)
+    cumulative = 0.0
+    while len(table) < max_entries:
+        cumulative += probability
+        if 1.0 - cumulative < 1.0 / _U032_SCALE:
+            table.append(0xFFFFFFFF)
+            return table
+        table.append(min(int(cumulative * _U032_SCALE), 0xFFFFFFFF))
+        probability *= lambda_val / len(table)
+    return None
+
 
 class SpikeSourcePoisson(
         AbstractPartitionableVertex,
@@ -60,24 +150,23 @@ class SpikeSourcePoisson(
                ('POISSON_PARAMS_REGION', 1),
                ('SPIKE_HISTORY_REGION', 2),
                ('BUFFERING_OUT_STATE', 3),
-               ('PROVENANCE_REGION', 4)])
+               ('PROVENANCE_REGION', 4),
+               ('RATE_UPDATE_REGION', 5),
+               ('RATE_SCHEDULE_REGION', 6),
+               ('FAST_RATE_REGION', 7)])
 
     _N_POPULATION_RECORDING_REGIONS = 1
-    _DEFAULT_MALLOCS_USED = 2
+    _DEFAULT_MALLOCS_USED = 5
 
     # Technically, this is ~2900 in terms of DTCM, but is timescale dependent
     # in terms of CPU (2900 at 10 times slow down is fine, but not at
     # real-time)
     _model_based_max_atoms_per_core = 500
 
-    # A count of the number of poisson subvertices, to work out the random
-    # back off range
-    _n_poisson_subvertices = 0
-
     def __init__(
             self, n_neurons, machine_time_step, timescale_factor,
             constraints=None, label="SpikeSourcePoisson", rate=1.0, start=0.0,
-            duration=None, seed=None):
+            duration=None, seed=None, rate_schedule=None):
         AbstractPartitionableVertex.__init__(
             self, n_neurons, label, self._model_based_max_atoms_per_core,
             constraints)
@@ -93,6 +182,29 @@ class SpikeSourcePoisson(
         self._start = start
         self._duration = duration
         self._rng = numpy.random.RandomState(seed)
+        self._rate_schedule = rate_schedule
+
+        # The rate of each source as last written to the machine, the
+        # sequence number of the last rate update sent to each placement, the
+        # rates of that update by source in the slice, kept until the core
+        # acknowledges them, and the highest rate each placement was mapped
+        # for
+        self._source_rates = numpy.zeros(n_neurons)
+        self._rate_update_sequences = dict()
+        self._pending_rate_updates = dict()
+        self._mapped_max_rates = dict()
+        self._timesteps_per_tick = config.getint(
+            "Simulation", "timesteps_per_timer_tick")
+        self._fast_method = config.get("Simulation", "poisson_fast_method")
+        if self._fast_method not in ("multiply", "inverse_cdf"):
+            raise exceptions.SpynnakerException(
+                "Unknown poisson_fast_method {}".format(self._fast_method))
+        self._cdf_table_dtcm_bytes = config.getint(
+            "Simulation", "poisson_cdf_table_dtcm_bytes")
+        self._normal_lambda = config.getfloat(
+            "Simulation", "poisson_normal_lambda")
+        self._send_slots_per_tick = config.getint(
+            "Simulation", "poisson_send_slots_per_tick")
 
         # Prepare for recording, and to get spikes
         self._spike_recorder = SpikeRecorder(machine_time_step)
@@ -116,7 +228,6 @@ class SpikeSourcePoisson(
     def create_subvertex(
             self, vertex_slice, resources_required, label=None,
             constraints=None):
-        SpikeSourcePoisson._n_poisson_subvertices += 1
         subvertex = SpikeSourcePoissonPartitionedVertex(
             resources_required, label, self._spike_recorder.record,
             constraints)
@@ -163,6 +274,14 @@ class SpikeSourcePoisson(
     def duration(self, duration):
         self._duration = duration
 
+    @property
+    def rate_schedule(self):
+        return self._rate_schedule
+
+    @rate_schedule.setter
+    def rate_schedule(self, rate_schedule):
+        self._rate_schedule = rate_schedule
+
     @property
     def seed(self):
         return self._seed
@@ -190,14 +309,44 @@ class SpikeSourcePoisson(
                 (((vertex_slice.hi_atom - vertex_slice.lo_atom) + 1) *
                  PARAMS_WORDS_PER_NEURON)) * 4
 
+    @staticmethod
+    def get_rate_update_bytes(vertex_slice):
+        """ Gets the size of the rate update region in bytes
+        :param vertex_slice:
+        """
+        return (RATE_UPDATE_HEADER_WORDS +
+                (vertex_slice.n_atoms * RATE_UPDATE_WORDS)) * 4
+
+    @staticmethod
+    def get_rate_schedule_bytes(rate_schedule):
+        """ Gets the size of the rate schedule region in bytes
+        :param rate_schedule: The scheduled rate changes of a slice
+        """
+        return (RATE_SCHEDULE_HEADER_WORDS +
+                (len(rate_schedule) * RATE_SCHEDULE_WORDS)) * 4
+
+    def get_max_fast_rate_bytes(self, vertex_slice):
+        """ Gets the largest size of the fast rate region in bytes; there is\
+            at most one rate for each source, and the tables share a fixed\
+            budget
+        :param vertex_slice:
+        """
+        return ((FAST_RATE_HEADER_WORDS +
+                 (vertex_slice.n_atoms * FAST_RATE_WORDS)) * 4 +
+                self._cdf_table_dtcm_bytes)
+
     def reserve_memory_regions(self, spec, setup_sz, poisson_params_sz,
-                               spike_hist_buff_sz, subvertex):
+                               spike_hist_buff_sz, rate_update_sz,
+                               rate_schedule_sz, fast_rate_sz, subvertex):
         """ Reserve memory regions for poisson source parameters and output\
             buffer.
         :param spec:
         :param setup_sz:
         :param poisson_params_sz:
         :param spike_hist_buff_sz:
+        :param rate_update_sz:
+        :param rate_schedule_sz:
+        :param fast_rate_sz:
         :return:
         """
         spec.comment("\nReserving memory space for data regions:\n\n")
@@ -221,6 +370,21 @@ class SpikeSourcePoisson(
                 _POISSON_SPIKE_SOURCE_REGIONS.SPIKE_HISTORY_REGION.value],
             [spike_hist_buff_sz])
         subvertex.reserve_provenance_data_region(spec)
+        spec.reserve_memory_region(
+            region=(
+                SpikeSourcePoissonPartitionedVertex.
+                _POISSON_SPIKE_SOURCE_REGIONS.RATE_UPDATE_REGION.value),
+            size=rate_update_sz, label='RateUpdates')
+        spec.reserve_memory_region(
+            region=(
+                SpikeSourcePoissonPartitionedVertex.
+                _POISSON_SPIKE_SOURCE_REGIONS.RATE_SCHEDULE_REGION.value),
+            size=rate_schedule_sz, label='RateSchedule')
+        spec.reserve_memory_region(
+            region=(
+                SpikeSourcePoissonPartitionedVertex.
+                _POISSON_SPIKE_SOURCE_REGIONS.FAST_RATE_REGION.value),
+            size=fast_rate_sz, label='FastRates')
 
     def _write_setup_info(
             self, spec, spike_history_region_sz, ip_tags,
@@ -271,9 +435,12 @@ class SpikeSourcePoisson(
             spec.write_value(data=1)
             spec.write_value(data=key)
 
-        # Write the random back off value
-        spec.write_value(random.randint(
-            0, SpikeSourcePoisson._n_poisson_subvertices))
+        # Write the number of slots over which to spread the spikes of each
+        # timer tick
+        spec.write_value(data=self._get_send_slots_per_tick())
+
+        # Write the number of time steps to run on each timer tick
+        spec.write_value(data=self._timesteps_per_tick)
 
         # Write the random seed (4 words), generated randomly!
         spec.write_value(data=self._rng.randint(0x7FFFFFFF))
@@ -290,7 +457,7 @@ class SpikeSourcePoisson(
             atom_id = vertex_slice.lo_atom + i
 
             # Get the parameter values for source i:
-            rate_val = generate_parameter(self._rate, atom_id)
+            rate_val = self._source_rates[atom_id]
             start_val = generate_parameter(self._start, atom_id)
             end_val = None
             if self._duration is not None:
@@ -343,13 +510,10 @@ class SpikeSourcePoisson(
         #     uint32_t start_ticks;
         #     uint32_t end_ticks;
         #
+        #     accum lambda;
         #     unsigned long fract exp_minus_lambda;
         #   } fast_spike_source_t;
         for (neuron_id, spikes_per_tick, start_val, end_val) in fast_sources:
-            if spikes_per_tick == 0:
-                exp_minus_lamda = 0
-            else:
-                exp_minus_lamda = math.exp(-1.0 * spikes_per_tick)
             start_scaled = int(start_val * 1000.0 / self._machine_time_step)
             end_scaled = 0xFFFFFFFF
             if end_val is not None:
@@ -357,7 +521,337 @@ class SpikeSourcePoisson(
             spec.write_value(data=neuron_id, data_type=DataType.UINT32)
             spec.write_value(data=start_scaled, data_type=DataType.UINT32)
             spec.write_value(data=end_scaled, data_type=DataType.UINT32)
-            spec.write_value(data=exp_minus_lamda, data_type=DataType.U032)
+            spec.write_value(
+                data=_s1615_word(spikes_per_tick), data_type=DataType.INT32)
+            spec.write_value(
+                data=_u032_word(math.exp(-1.0 * spikes_per_tick)),
+                data_type=DataType.UINT32)
+
+    def _get_send_slots_per_tick(self):
+        """ Get the number of slots over which to spread the spikes of each\
+            timer tick; this is at most the number configured, gives slots of\
+            at least _MIN_SEND_SLOT_US and divides the timer period exactly
+        """
+        timer_period = int(self._machine_time_step * self._timescale_factor)
+        n_slots = max(1, min(
+            self._send_slots_per_tick, timer_period // _MIN_SEND_SLOT_US))
+        while timer_period % n_slots != 0:
+            n_slots -= 1
+        return n_slots
+
+    def _get_rate_update_values(self, rate_val):
+        """ Get the mean inter-spike interval in time steps and lambda to\
+            send to the machine for a rate, only one of which is non-zero\
+            depending on whether the rate is slow or fast
+        """
+        spikes_per_tick = \
+            (float(rate_val) * (self._machine_time_step / 1000000.0))
+        if spikes_per_tick == 0:
+            return 0, 0
+        if spikes_per_tick <= SLOW_RATE_PER_TICK_CUTOFF:
+            return 1.0 / spikes_per_tick, 0
+        return 0, spikes_per_tick
+
+    def _get_fast_rates(self, vertex_slice, rate_schedule):
+        """ Get how to draw the number of spikes for each distinct fast rate\
+            used by the sources of a slice, initially or in the rate schedule.\
+            The rates used by most sources come first for the budget of\
+            tables; a rate without a table is left out, and so uses the\
+            multiplicative method.  Rates changed to on the machine are not\
+            known in advance, and so also use the multiplicative method.
+
+        :return: A list of (lambda word, method, lambda, table), in order of\
+            lambda
+        """
+        uses = [(rate_val, 1) for rate_val in self._source_rates[
+            vertex_slice.lo_atom:vertex_slice.hi_atom + 1]]
+        uses.extend(
+            (rate_val, n_ids) for (_, _, n_ids, rate_val) in rate_schedule)
+        counts = dict()
+        for rate_val, n_sources in uses:
+            _, lambda_val = self._get_rate_update_values(rate_val)
+            if lambda_val != 0:
+                word = _s1615_word(lambda_val)
+                count, _ = counts.get(word, (0, lambda_val))
+                counts[word] = (count + n_sources, lambda_val)
+
+        fast_rates = list()
+        table_words = self._cdf_table_dtcm_bytes / 4
+        for word, (_, lambda_val) in sorted(
+                counts.iteritems(), key=lambda item: -item[1][0]):
+            if len(fast_rates) == vertex_slice.n_atoms:
+                break
+            if self._normal_lambda > 0 and lambda_val >= self._normal_lambda:
+                fast_rates.append(
+                    (word, _FAST_RATE_NORMAL, lambda_val, list()))
+            elif self._fast_method == "inverse_cdf":
+                table = get_poisson_cdf_table(lambda_val, table_words)
+                if table is not None:
+                    table_words -= len(table)
+                    fast_rates.append(
+                        (word, _FAST_RATE_INVERSE_CDF, lambda_val, table))
+        fast_rates.sort()
+        return fast_rates
+
+    def _write_fast_rates(self, spec, fast_rates):
+        """ Write the fast rates of a slice
+        """
+        spec.switch_write_focus(
+            region=(
+                SpikeSourcePoissonPartitionedVertex.
+                _POISSON_SPIKE_SOURCE_REGIONS.FAST_RATE_REGION.value))
+        spec.write_value(data=len(fast_rates))
+        spec.write_value(data=sum(
+            FAST_RATE_WORDS + len(table) for (_, _, _, table) in fast_rates))
+        for (word, method, lambda_val, table) in fast_rates:
+            spec.write_value(data=method, data_type=DataType.UINT32)
+            spec.write_value(data=word, data_type=DataType.INT32)
+            spec.write_value(
+                data=_s1615_word(math.sqrt(lambda_val)),
+                data_type=DataType.INT32)
+            spec.write_value(data=len(table), data_type=DataType.UINT32)
+            for entry in table:
+                spec.write_value(data=entry, data_type=DataType.UINT32)
+
+    def _get_rate_schedule(self, vertex_slice):
+        """ Get the scheduled rate changes of the sources in a slice, in\
+            order of time step, merging the changes of consecutive sources to\
+            the same rate at the same time step
+
+        :return: A list of (time step, first neuron id in the slice, number\
+            of neurons, rate)
+        """
+        if self._rate_schedule is None or len(self._rate_schedule) == 0:
+            return list()
+
+        # The schedule is either one list of (time, rate) for every source,
+        # or a list of (time, rate) for each source
+        shared = all(
+            len(change) == 2 and numpy.isscalar(change[0]) and
+            numpy.isscalar(change[1]) for change in self._rate_schedule)
+        if not shared and len(self._rate_schedule) != self.n_atoms:
+            raise exceptions.SpynnakerException(
+                "The rate schedule of {} must be a list of (time, rate) or"
+                " one such list for each of its {} sources".format(
+                    self._label, self.n_atoms))
+
+        # Find the rate of each source from each time step at which it
+        # changes, the last change given for a time step winning
+        changes = list()
+        for i in range(vertex_slice.n_atoms):
+            neuron_schedule = self._rate_schedule
+            if not shared:
+                neuron_schedule = self._rate_schedule[vertex_slice.lo_atom + i]
+            neuron_changes = dict()
+            for (time_val, rate_val) in neuron_schedule:
+                if time_val < 0 or rate_val < 0:
+                    raise exceptions.SpynnakerException(
+                        "The rate schedule of {} has a negative time or"
+                        " rate".format(self._label))
+                tick = int(round(
+                    time_val * 1000.0 / self._machine_time_step))
+                neuron_changes[tick] = float(rate_val)
+            changes.extend(
+                (tick, i, rate_val)
+                for tick, rate_val in neuron_changes.iteritems())
+        changes.sort()
+
+        # Merge the changes of runs of consecutive sources
+        schedule = list()
+        for (tick, neuron_id, rate_val) in changes:
+            if (len(schedule) > 0 and schedule[-1][0] == tick and
+                    schedule[-1][3] == rate_val and
+                    schedule[-1][1] + schedule[-1][2] == neuron_id):
+                schedule[-1][2] += 1
+            else:
+                schedule.append([tick, neuron_id, 1, rate_val])
+        return schedule
+
+    def get_max_rate(self, vertex_slice):
+        """ Get the highest rate of the sources of a slice, initially or in\
+            the rate schedule.  Whatever receives the spikes of the sources\
+            is sized for this rate when the simulation is mapped, so\
+            update_rates_on_machine rejects any rate above it.
+        """
+        max_rate = self._rate
+        if hasattr(max_rate, "__getitem__"):
+            max_rate = max(
+                max_rate[vertex_slice.lo_atom:vertex_slice.hi_atom + 1])
+        elif isinstance(max_rate, RandomDistribution):
+            max_rate = utility_calls.get_maximum_probable_value(
+                max_rate, vertex_slice.n_atoms)
+        for (_, _, _, rate_val) in self._get_rate_schedule(vertex_slice):
+            max_rate = max(max_rate, rate_val)
+        return max_rate
+
+    def _pack_rate_update(self, first_id, n_ids, rate_val):
+        """ Pack a rate update of a range of sources as sent to the machine
+        """
+        isi_val, lambda_val = self._get_rate_update_values(rate_val)
+        exp_minus_lambda = 0
+        if lambda_val != 0:
+            exp_minus_lambda = _u032_word(math.exp(-lambda_val))
+        return struct.pack(
+            "<IIiiI", first_id, n_ids, _s1615_word(isi_val),
+            _s1615_word(lambda_val), exp_minus_lambda)
+
+    @staticmethod
+    def _get_rate_update_address(transceiver, placement):
+        """ Get the address of the rate update region of a core
+        """
+        return helpful_functions.locate_memory_region_for_placement(
+            placement,
+            SpikeSourcePoissonPartitionedVertex.
+            _POISSON_SPIKE_SOURCE_REGIONS.RATE_UPDATE_REGION.value,
+            transceiver)
+
+    @staticmethod
+    def _read_rate_update_ack(transceiver, placement, address):
+        """ Read the sequence number of the last rate update that a core has\
+            applied
+        """
+        return struct.unpack_from("<I", buffer(transceiver.read_memory(
+            placement.x, placement.y, address + 4, 4)))[0]
+
+    def _wait_for_rate_update_ack(self, transceiver, placement, address):
+        """ Wait for a core to acknowledge the last rate update sent to it
+        """
+        sequence = self._rate_update_sequences[
+            (placement.x, placement.y, placement.p)]
+        timeout = _RATE_UPDATE_ACK_TIMEOUT + (
+            _RATE_UPDATE_ACK_TIMEOUT_TICKS * self._machine_time_step *
+            self._timescale_factor / 1000000.0)
+        end_time = time.time() + timeout
+        while True:
+            if self._read_rate_update_ack(
+                    transceiver, placement, address) == sequence:
+                return
+            if time.time() > end_time:
+                raise exceptions.SpynnakerException(
+                    "Rate update {} to {} on {}, {}, {} was not acknowledged"
+                    " within {} seconds; is the simulation running?".format(
+                        sequence, self._label, placement.x, placement.y,
+                        placement.p, timeout))
+            time.sleep(0.001)
+
+    def set_rates(self, rate, neuron_ids):
+        """ Change the rates of some of the sources before the simulation is\
+            loaded on to the machine
+
+        :param rate: The new rate, or a list of rates, one per neuron id
+        :param neuron_ids: The ids of the sources to change
+        """
+        rates = numpy.array([
+            generate_parameter(self._rate, i) for i in range(self.n_atoms)])
+        rates[numpy.asarray(neuron_ids)] = rate
+        self.set_value("rate", rates)
+
+    def update_rates_on_machine(
+            self, rate, neuron_ids, transceiver, placements, graph_mapper,
+            wait=False):
+        """ Change the rates of some of the sources while the simulation is\
+            on the machine, without reloading it.  Each core picks up the new\
+            rates at its next timer tick, or when the simulation is next\
+            resumed if it is paused, and acknowledges them; sources that\
+            change between slow and fast rates are moved as needed.  The new\
+            rates may not be above the highest rate of the sources when the\
+            simulation was mapped (see get_max_rate); to go higher, set the\
+            rate or rate schedule before the simulation is run.
+
+            An update which a core has not yet acknowledged is replaced by\
+            one with both its rates and the new ones, the new ones winning\
+            where they overlap, so any number of changes can be made while\
+            the simulation is paused.
+
+        :param rate: The new rate, or a list of rates, one per neuron id
+        :param neuron_ids: The ids of the sources to change
+        :param wait: Whether to wait for each core to acknowledge the\
+            update; this needs the simulation to be running, as a paused\
+            core only picks the update up when the simulation is resumed
+        """
+        neuron_ids = numpy.asarray(neuron_ids, dtype="uint32")
+        rates = numpy.zeros(len(neuron_ids))
+        rates[:] = rate
+
+        # Sort by neuron id, keeping the last rate given for each
+        order = numpy.argsort(neuron_ids, kind="mergesort")
+        neuron_ids = neuron_ids[order]
+        rates = rates[order]
+        last = numpy.append(neuron_ids[1:] != neuron_ids[:-1], True)
+        neuron_ids = neuron_ids[last]
+        rates = rates[last]
+
+        # Check all the new rates before sending any of them; the rates as
+        # changed on the machine are not what each core was mapped for
+        slices = list()
+        for subvertex in graph_mapper.get_subvertices_from_vertex(self):
+            vertex_slice = graph_mapper.get_subvertex_slice(subvertex)
+            in_slice = ((neuron_ids >= vertex_slice.lo_atom) &
+                        (neuron_ids <= vertex_slice.hi_atom))
+            if not numpy.any(in_slice):
+                continue
+            placement = placements.get_placement_of_subvertex(subvertex)
+            max_rate = self._mapped_max_rates[
+                (placement.x, placement.y, placement.p)]
+            if numpy.any(rates[in_slice] > max_rate):
+                raise exceptions.SpynnakerException(
+                    "Cannot change the rate of sources of {} to {} Hz on the"
+                    " machine, as the simulation was mapped for rates of at"
+                    " most {} Hz".format(
+                        self._label, numpy.max(rates[in_slice]), max_rate))
+            slices.append((placement, vertex_slice, in_slice))
+
+        sent = list()
+        for placement, vertex_slice, in_slice in slices:
+            core = (placement.x, placement.y, placement.p)
+            address = self._get_rate_update_address(transceiver, placement)
+
+            # Add the new rates to those of the last update if the core has
+            # not yet acknowledged it
+            sequence = self._rate_update_sequences[core]
+            pending = self._pending_rate_updates.get(core, dict())
+            if self._read_rate_update_ack(
+                    transceiver, placement, address) == sequence:
+                pending = dict()
+            for neuron_id, rate_val in zip(
+                    neuron_ids[in_slice] - vertex_slice.lo_atom,
+                    rates[in_slice]):
+                pending[int(neuron_id)] = rate_val
+
+            # Make one update for each run of consecutive sources with the
+            # same new rate
+            updates = list()
+            for neuron_id in sorted(pending):
+                rate_val = pending[neuron_id]
+                if (len(updates) > 0 and updates[-1][2] == rate_val and
+                        updates[-1][0] + updates[-1][1] == neuron_id):
+                    updates[-1][1] += 1
+                else:
+                    updates.append([neuron_id, 1, rate_val])
+            data = struct.pack("<I", len(updates))
+            for first_id, n_ids, rate_val in updates:
+                data += self._pack_rate_update(first_id, n_ids, rate_val)
+
+            # Write the updates, and then the new sequence number; should the
+            # core read the updates as they are overwritten, it applies all
+            # of them again when it sees the new sequence number
+            transceiver.write_memory(
+                placement.x, placement.y, address + 8, data)
+            self._rate_update_sequences[core] = sequence + 1
+            self._pending_rate_updates[core] = pending
+            transceiver.write_memory(
+                placement.x, placement.y, address,
+                struct.pack("<I", sequence + 1))
+            self._source_rates[neuron_ids[in_slice]] = rates[in_slice]
+            sent.append((placement, address))
+
+        # Remember the new rates in case the simulation is reloaded
+        self._rate = numpy.array(self._source_rates)
+
+        if wait:
+            for placement, address in sent:
+                self._wait_for_rate_update_ack(
+                    transceiver, placement, address)
 
     # @implements AbstractSpikeRecordable.is_recording_spikes
     def is_recording_spikes(self):
@@ -375,8 +869,13 @@ class SpikeSourcePoisson(
               DATA_SPECABLE_BASIC_SETUP_INFO_N_WORDS * 4) +
              ReceiveBuffersToHostBasicImpl.get_recording_data_size(1) +
              ReceiveBuffersToHostBasicImpl.get_buffer_state_region_size(1) +
-             SpikeSourcePoissonPartitionedVertex.get_provenance_data_size(0) +
-             poisson_params_sz)
+             SpikeSourcePoissonPartitionedVertex.get_provenance_data_size(
+                 SpikeSourcePoissonPartitionedVertex.
+                 N_ADDITIONAL_PROVENANCE_DATA_ITEMS) +
+             poisson_params_sz + self.get_rate_update_bytes(vertex_slice) +
+             self.get_rate_schedule_bytes(
+                 self._get_rate_schedule(vertex_slice)) +
+             self.get_max_fast_rate_bytes(vertex_slice))
         total_size += self._get_number_of_mallocs_used_by_dsg(
             vertex_slice, graph.incoming_edges_to_vertex(self)) * \
             front_end_common_constants.SARK_PER_MALLOC_SDRAM_USAGE
@@ -399,7 +898,22 @@ class SpikeSourcePoisson(
         return standard_mallocs
 
     def get_dtcm_usage_for_atoms(self, vertex_slice, graph):
-        return 0
+
+        # Each source has an entry in the slow and fast source arrays and the
+        # slow spike queue, room for two spikes in the queue of spikes to send
+        # for each time step of a timer tick, and a bit in the bit field of
+        # updated sources; the fast rates are copied from the fast rate region
+        # along with a pointer to each, and there is at most one rate for
+        # each source
+        n_atoms = vertex_slice.n_atoms
+        return (
+            (n_atoms * (_SLOW_SOURCE_DTCM_WORDS + _FAST_SOURCE_DTCM_WORDS +
+                        _SLOW_SPIKE_EVENT_DTCM_WORDS) * 4) +
+            (n_atoms * 2 * self._timesteps_per_tick * 4) +
+            (int(math.ceil(n_atoms / 32.0)) * 4) +
+            (self.get_max_fast_rate_bytes(vertex_slice) -
+             (FAST_RATE_HEADER_WORDS * 4)) +
+            (n_atoms * 4))
 
     def get_cpu_usage_for_atoms(self, vertex_slice, graph):
         return 0
@@ -437,10 +951,24 @@ class SpikeSourcePoisson(
                     subvertex.get_recording_data_size(1))
 
         poisson_params_sz = self.get_params_bytes(vertex_slice)
+        rate_update_sz = self.get_rate_update_bytes(vertex_slice)
+        rate_schedule = self._get_rate_schedule(vertex_slice)
+        rate_schedule_sz = self.get_rate_schedule_bytes(rate_schedule)
+
+        # Get the rates of the sources, and how to draw the spikes of each
+        # distinct fast rate
+        for atom_id in range(vertex_slice.lo_atom, vertex_slice.hi_atom + 1):
+            self._source_rates[atom_id] = generate_parameter(
+                self._rate, atom_id)
+        fast_rates = self._get_fast_rates(vertex_slice, rate_schedule)
+        fast_rate_sz = (FAST_RATE_HEADER_WORDS + sum(
+            FAST_RATE_WORDS + len(table)
+            for (_, _, _, table) in fast_rates)) * 4
 
         # Reserve SDRAM space for memory areas:
         self.reserve_memory_regions(
-            spec, setup_sz, poisson_params_sz, spike_history_sz, subvertex)
+            spec, setup_sz, poisson_params_sz, spike_history_sz,
+            rate_update_sz, rate_schedule_sz, fast_rate_sz, subvertex)
 
         self._write_setup_info(
             spec, spike_history_sz, ip_tags, buffer_size_before_receive,
@@ -456,6 +984,34 @@ class SpikeSourcePoisson(
             key = keys_and_masks[0].key
 
         self._write_poisson_parameters(spec, key, vertex_slice)
+        self._write_fast_rates(spec, fast_rates)
+
+        # Write the header of the rate update region, with no updates
+        spec.switch_write_focus(
+            region=(
+                SpikeSourcePoissonPartitionedVertex.
+                _POISSON_SPIKE_SOURCE_REGIONS.RATE_UPDATE_REGION.value))
+        spec.write_value(data=0)
+        spec.write_value(data=0)
+        spec.write_value(data=0)
+        self._rate_update_sequences[
+            (placement.x, placement.y, placement.p)] = 0
+        self._pending_rate_updates.pop(
+            (placement.x, placement.y, placement.p), None)
+        self._mapped_max_rates[(placement.x, placement.y, placement.p)] = \
+            self.get_max_rate(vertex_slice)
+
+        # Write the scheduled rate changes
+        spec.switch_write_focus(
+            region=(
+                SpikeSourcePoissonPartitionedVertex.
+                _POISSON_SPIKE_SOURCE_REGIONS.RATE_SCHEDULE_REGION.value))
+        spec.write_value(data=len(rate_schedule))
+        for (tick, first_id, n_ids, rate_val) in rate_schedule:
+            spec.write_value(data=tick, data_type=DataType.UINT32)
+            update = self._pack_rate_update(first_id, n_ids, rate_val)
+            for word in struct.unpack("<IIIII", update):
+                spec.write_value(data=word, data_type=DataType.UINT32)
 
         # End-of-Spec:
         spec.end_specification()
@@ -7,6 +7,8 @@ from spinn_front_end_common.abstract_models.abstract_recordable \
 from spinn_front_end_common.interface.provenance\
     .provides_provenance_data_from_machine_impl \
     import ProvidesProvenanceDataFromMachineImpl
+from spinn_front_end_common.utilities.utility_objs\
+    .provenance_data_item import ProvenanceDataItem
 
 from enum import Enum
 
@@ -21,7 +23,22 @@ class SpikeSourcePoissonPartitionedVertex(
                ('POISSON_PARAMS_REGION', 1),
                ('SPIKE_HISTORY_REGION', 2),
                ('BUFFERING_OUT_STATE', 3),
-               ('PROVENANCE_REGION', 4)])
+               ('PROVENANCE_REGION', 4),
+               ('RATE_UPDATE_REGION', 5),
+               ('RATE_SCHEDULE_REGION', 6),
+               ('FAST_RATE_REGION', 7)])
+
+    # entries for the provenance data generated by the Poisson source
+    EXTRA_PROVENANCE_DATA_ENTRIES = Enum(
+        value="EXTRA_PROVENANCE_DATA_ENTRIES",
+        names=[("PACED_SPIKE_COUNT", 0),
+               ("BLOCKING_SPIKE_COUNT", 1),
+               ("SEND_DEFERRAL_COUNT", 2),
+               ("SEND_WAIT_CYCLES", 3),
+               ("IDLE_CYCLES_LOW", 4),
+               ("IDLE_CYCLES_HIGH", 5)])
+
+    N_ADDITIONAL_PROVENANCE_DATA_ITEMS = 6
 
     def __init__(
             self, resources_required, label, is_recording, constraints=None):
@@ -30,9 +47,60 @@ class SpikeSourcePoissonPartitionedVertex(
         ReceiveBuffersToHostBasicImpl.__init__(self)
         ProvidesProvenanceDataFromMachineImpl.__init__(
             self, self._POISSON_SPIKE_SOURCE_REGIONS.PROVENANCE_REGION.value,
-            0)
+            self.N_ADDITIONAL_PROVENANCE_DATA_ITEMS)
         AbstractRecordable.__init__(self)
         self._is_recording = is_recording
 
     def is_recording(self):
         return self._is_recording
+
+    def get_provenance_data_from_machine(self, transceiver, placement):
+        provenance_data = self._read_provenance_data(transceiver, placement)
+        provenance_items = self._read_basic_provenance_items(
+            provenance_data, placement)
+        provenance_data = self._get_remaining_provenance_data_items(
+            provenance_data)
+
+        n_paced_spikes = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.PACED_SPIKE_COUNT.value]
+        n_blocking_spikes = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.BLOCKING_SPIKE_COUNT.value]
+        n_send_deferrals = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.SEND_DEFERRAL_COUNT.value]
+        send_wait_cycles = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.SEND_WAIT_CYCLES.value]
+        idle_cycles = (
+            (int(provenance_data[
+                self.EXTRA_PROVENANCE_DATA_ENTRIES.IDLE_CYCLES_HIGH.value])
+             << 32) |
+            int(provenance_data[
+                self.EXTRA_PROVENANCE_DATA_ENTRIES.IDLE_CYCLES_LOW.value]))
+
+        label, x, y, p, names = self._get_placement_details(placement)
+
+        # translate into provenance data items
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Spikes_sent_paced"), n_paced_spikes))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Spikes_sent_waiting_for_space"),
+            n_blocking_spikes))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Times_a_send_slot_found_no_space"),
+            n_send_deferrals))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Cycles_waiting_for_space_to_send"),
+            send_wait_cycles,
+            report=send_wait_cycles > 0,
+            message=(
+                "{} on {}, {}, {} spent {} cycles waiting for space to send "
+                "spikes, as more spikes were generated in some timer ticks "
+                "than could be sent in them. Please increase the "
+                "time_scale_factor, or reduce the number of sources per "
+                "core.".format(label, x, y, p, send_wait_cycles))))
+
+        # The cycles left after each timer callback, which were spent in a
+        # random back-off before the spikes were paced across the tick
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Idle_cycles_after_timer_callbacks"),
+            idle_cycles))
+        return provenance_items
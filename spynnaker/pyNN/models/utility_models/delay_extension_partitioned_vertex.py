@@ -1,13 +1,20 @@
 from pacman.model.partitioned_graph.partitioned_vertex import PartitionedVertex
+from spinn_front_end_common.utilities.utility_objs\
+    .provenance_data_item import ProvenanceDataItem
 from spinn_front_end_common.interface.provenance\
     .provides_provenance_data_from_machine_impl \
     import ProvidesProvenanceDataFromMachineImpl
 
+from spynnaker.pyNN.utilities import constants
+from spynnaker.pyNN.models.common.provides_profiler_provenance_impl \
+    import ProvidesProfilerProvenanceImpl
+
 from enum import Enum
 
 
 class DelayExtensionPartitionedVertex(
-        PartitionedVertex, ProvidesProvenanceDataFromMachineImpl):
+        PartitionedVertex, ProvidesProvenanceDataFromMachineImpl,
+        ProvidesProfilerProvenanceImpl):
 
     _DELAY_EXTENSION_REGIONS = Enum(
         value="DELAY_EXTENSION_REGIONS",
@@ -15,8 +22,72 @@ class DelayExtensionPartitionedVertex(
                ('DELAY_PARAMS', 1),
                ('PROVENANCE_REGION', 2)])
 
+    # entries for the provenance data generated by the delay extension
+    EXTRA_PROVENANCE_DATA_ENTRIES = Enum(
+        value="EXTRA_PROVENANCE_DATA_ENTRIES",
+        names=[("BUFFER_OVERFLOW_COUNT", 0),
+               ("COUNTER_SATURATION_COUNT", 1),
+               ("INVALID_KEY_COUNT", 2),
+               ("PROFILER_DATA_START", 3)])
+
+    N_ADDITIONAL_PROVENANCE_DATA_ITEMS = (
+        3 + constants.PROFILER_PROVENANCE_WORDS)
+
     def __init__(self, resources_required, label, constraints=None):
         PartitionedVertex.__init__(
             self, resources_required, label, constraints=constraints)
         ProvidesProvenanceDataFromMachineImpl.__init__(
-            self, self._DELAY_EXTENSION_REGIONS.PROVENANCE_REGION.value, 0)
+            self, self._DELAY_EXTENSION_REGIONS.PROVENANCE_REGION.value,
+            self.N_ADDITIONAL_PROVENANCE_DATA_ITEMS)
+
+    def get_provenance_data_from_machine(self, transceiver, placement):
+        provenance_data = self._read_provenance_data(transceiver, placement)
+        provenance_items = self._read_basic_provenance_items(
+            provenance_data, placement)
+        provenance_data = self._get_remaining_provenance_data_items(
+            provenance_data)
+
+        n_buffer_overflows = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.BUFFER_OVERFLOW_COUNT.value]
+        n_counter_saturations = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.COUNTER_SATURATION_COUNT.value]
+        n_invalid_keys = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.INVALID_KEY_COUNT.value]
+
+        label, x, y, p, names = self._get_placement_details(placement)
+
+        # translate into provenance data items
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Times_the_input_buffer_lost_packets"),
+            n_buffer_overflows,
+            report=n_buffer_overflows > 0,
+            message=(
+                "The input buffer for {} on {}, {}, {} lost packets on {} "
+                "occasions, so these spikes were not delayed. Please "
+                "increase the spikes_per_second or ring_buffer_sigma values "
+                "located within the .spynnaker.cfg file, or the "
+                "time_scale_factor.".format(
+                    label, x, y, p, n_buffer_overflows))))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Times_the_spike_counters_saturated"),
+            n_counter_saturations,
+            report=n_counter_saturations > 0,
+            message=(
+                "{} spikes received by {} on {}, {}, {} were not delayed as "
+                "more than 255 spikes from the same neuron arrived in one "
+                "time step.".format(
+                    n_counter_saturations, label, x, y, p))))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Packets_with_invalid_keys"),
+            n_invalid_keys,
+            report=n_invalid_keys > 0,
+            message=(
+                "{} packets received by {} on {}, {}, {} had keys which did "
+                "not match the source population, so were discarded. This "
+                "is a sign of a routing error.".format(
+                    n_invalid_keys, label, x, y, p))))
+        provenance_items.extend(self._get_profiler_provenance_items(
+            provenance_data[
+                self.EXTRA_PROVENANCE_DATA_ENTRIES.PROFILER_DATA_START.value:],
+            label, x, y, p, names))
+        return provenance_items
@@ -1,5 +1,7 @@
 
-from spynnaker.pyNN.utilities import constants
+from spynnaker.pyNN.utilities.conf import config
+from spynnaker.pyNN.models.spike_source.spike_source_poisson \
+    import SpikeSourcePoisson
 from spynnaker.pyNN.models.utility_models.delay_block import DelayBlock
 from spynnaker.pyNN.models.utility_models.delay_extension_partitioned_vertex \
     import DelayExtensionPartitionedVertex
@@ -26,12 +28,19 @@ from pacman.model.partitionable_graph.abstract_partitionable_vertex \
 from data_specification.data_specification_generator\
     import DataSpecificationGenerator
 
+
 import logging
 import math
 
 logger = logging.getLogger(__name__)
 
-_DELAY_PARAM_HEADER_WORDS = 5
+_DELAY_PARAM_HEADER_WORDS = 7
+
+# The smallest incoming spike buffer, in spikes
+_MIN_INCOMING_SPIKE_BUFFER_SIZE = 32
+
+# The length of a delay stage in time steps, and so in delay slots
+_DELAY_STAGE_LENGTH = 16
 
 
 class DelayExtensionVertex(
@@ -62,6 +71,11 @@ class DelayExtensionVertex(
         self._source_vertex = source_vertex
         self._n_delay_stages = 0
         self._delay_per_stage = delay_per_stage
+        self._timesteps_per_tick = config.getint(
+            "Simulation", "timesteps_per_timer_tick")
+        self._spikes_per_second = config.getfloat(
+            "Simulation", "spikes_per_second")
+        self._sigma = config.getfloat("Simulation", "ring_buffer_sigma")
 
         # Dictionary of vertex_slice -> delay block for data specification
         self._delay_blocks = dict()
@@ -104,6 +118,29 @@ class DelayExtensionVertex(
         [self._delay_blocks[key].add_delay(source_id, stage)
             for (source_id, stage) in zip(source_ids, stages)]
 
+    def _get_incoming_spike_buffer_size(self, vertex_slice):
+        """ Get the number of spikes the incoming spike buffer of the core\
+            for a slice must hold: those the slice of the source vertex is\
+            expected to send in one timer tick at its maximum rate (the\
+            highest initial or scheduled rate of a Poisson spike source,\
+            spikes_per_second otherwise), plus ring_buffer_sigma standard\
+            deviations, and at least a spike from every neuron of the slice,\
+            as these arrive together.  This is rounded up to a power of two\
+            as the buffer is on the core
+        """
+        max_rate = self._spikes_per_second
+        if isinstance(self._source_vertex, SpikeSourcePoisson):
+            max_rate = self._source_vertex.get_max_rate(vertex_slice)
+
+        ticks_per_second = (
+            1000000.0 / (self._machine_time_step * self._timesteps_per_tick))
+        mean_spikes = (vertex_slice.n_atoms * max_rate) / ticks_per_second
+        n_spikes = int(math.ceil(
+            mean_spikes + (self._sigma * math.sqrt(mean_spikes))))
+        n_spikes = max(
+            n_spikes, vertex_slice.n_atoms, _MIN_INCOMING_SPIKE_BUFFER_SIZE)
+        return 1 << (n_spikes - 1).bit_length()
+
     def generate_data_spec(
             self, subvertex, placement, partitioned_graph, graph, routing_info,
             hostname, graph_mapper, report_folder, ip_tags, reverse_ip_tags,
@@ -175,7 +212,8 @@ class DelayExtensionVertex(
                 incoming_mask = keys_and_masks[0].mask
 
         self.write_delay_parameters(
-            spec, vertex_slice, key, incoming_key, incoming_mask)
+            spec, vertex_slice, key, incoming_key, incoming_mask,
+            self._get_incoming_spike_buffer_size(vertex_slice))
         # End-of-Spec:
         spec.end_specification()
         data_writer.close()
@@ -191,7 +229,8 @@ class DelayExtensionVertex(
                 _DELAY_EXTENSION_REGIONS.SYSTEM.value))
 
     def write_delay_parameters(
-            self, spec, vertex_slice, key, incoming_key, incoming_mask):
+            self, spec, vertex_slice, key, incoming_key, incoming_mask,
+            incoming_spike_buffer_size):
         """ Generate Delay Parameter data
         """
 
@@ -217,6 +256,12 @@ class DelayExtensionVertex(
         # Write the number of blocks of delays:
         spec.write_value(data=self._n_delay_stages)
 
+        # Write the number of time steps to run on each timer tick
+        spec.write_value(data=self._timesteps_per_tick)
+
+        # Write the number of spikes the incoming spike buffer can hold
+        spec.write_value(data=incoming_spike_buffer_size)
+
         # Write the actual delay blocks
         spec.write_array(array_values=self._delay_blocks[(
             vertex_slice.lo_atom, vertex_slice.hi_atom)].delay_block)
@@ -230,19 +275,27 @@ class DelayExtensionVertex(
         size_of_mallocs = (
             self._DEFAULT_MALLOCS_USED *
             common_constants.SARK_PER_MALLOC_SDRAM_USAGE)
+        n_words_per_stage = int(math.ceil(vertex_slice.n_atoms / 32.0))
         return (
+            (common_constants.DATA_SPECABLE_BASIC_SETUP_INFO_N_WORDS * 4) +
+            (_DELAY_PARAM_HEADER_WORDS * 4) +
+            (n_words_per_stage * self._n_delay_stages * 4) +
             size_of_mallocs +
-            DelayExtensionPartitionedVertex.get_provenance_data_size(0))
-
-        n_words_per_stage = int(math.ceil(vertex_slice.n_atoms / 32.0))
-        return ((constants.BLOCK_INDEX_HEADER_WORDS * 4) +
-                (_DELAY_PARAM_HEADER_WORDS * 4) +
-                (n_words_per_stage * self._n_delay_stages * 4) +
-                size_of_mallocs)
+            DelayExtensionPartitionedVertex.get_provenance_data_size(
+                DelayExtensionPartitionedVertex.
+                N_ADDITIONAL_PROVENANCE_DATA_ITEMS))
 
     def get_dtcm_usage_for_atoms(self, vertex_slice, graph):
-        n_atoms = (vertex_slice.hi_atom - vertex_slice.lo_atom) + 1
-        return (44 + (16 * 4)) * n_atoms
+
+        # Each delay slot has a counter per neuron and a bit field of the
+        # active neurons, and each stage a bit field of its neurons
+        n_words_per_stage = int(math.ceil(vertex_slice.n_atoms / 32.0))
+        n_slots = max(self._n_delay_stages * _DELAY_STAGE_LENGTH, 1)
+        n_slots = 1 << (n_slots - 1).bit_length()
+        return ((n_slots * (
+                    vertex_slice.n_atoms + (n_words_per_stage * 4) + 8)) +
+                (self._n_delay_stages * ((n_words_per_stage * 4) + 4)) +
+                (self._get_incoming_spike_buffer_size(vertex_slice) * 4))
 
     def get_binary_file_name(self):
         return "delay_extension.aplx"
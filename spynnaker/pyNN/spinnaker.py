@@ -320,6 +320,11 @@ class Spinnaker(SpinnakerMainInterface):
         :param run_time: the time in ms to run the simulation for
         """
 
+        # Add the delay extensions of any new projections, now that the
+        # delays supported by the post-synaptic vertices are known
+        for projection in self._projections:
+            projection._add_delay_extension_if_needed()
+
         # extra post run algorithms
         self._dsg_algorithm = "SpynnakerDataSpecificationWriter"
         SpinnakerMainInterface.run(self, run_time)
@@ -38,12 +38,31 @@ SCALE = WEIGHT_FLOAT_TO_FIXED_SCALE * NA_TO_PA_SCALE
 
 # natively supported delays for all abstract_models
 MAX_SUPPORTED_DELAY_TICS = 16
+
+# the number of bits of the delay in a synaptic word; populations with small
+# enough cores can have deeper ring buffers, and so natively support delays of
+# up to 1 << SYNAPSE_DELAY_BITS time steps
+SYNAPSE_DELAY_BITS = 6
+SYNAPSE_DELAY_MASK = (1 << SYNAPSE_DELAY_BITS) - 1
 MAX_DELAY_BLOCKS = 8
 MAX_TIMER_TICS_SUPPORTED_PER_BLOCK = 16
 
 # the minimum supported delay slot between two neurons
 MIN_SUPPORTED_DELAY = 1
 
+# From profiler.h, and checked against it by test_constants; the phases
+# measured when the neuron binaries are built with PROFILER=PROFILER_ENABLED.
+# The delay extension binary measures only the Timer_callback phase
+PROFILER_PHASES = ["Timer_callback", "Synapse_transfer", "Neuron_update",
+                   "Recording", "DMA_row_processing"]
+PROFILER_N_BINS = 8
+PROFILER_WORDS_PER_PHASE = 5 + PROFILER_N_BINS
+PROFILER_PROVENANCE_WORDS = 2 + (
+    len(PROFILER_PHASES) * PROFILER_WORDS_PER_PHASE)
+
+# The fraction of the timer period above which a profiled phase is reported
+PROFILER_UTILISATION_WARNING = 0.9
+
 # Regions for populations
 POPULATION_BASED_REGIONS = Enum(
     value="POPULATION_BASED_REGIONS",
@@ -57,4 +76,5 @@ POPULATION_BASED_REGIONS = Enum(
            ('POTENTIAL_HISTORY', 7),
            ('GSYN_HISTORY', 8),
            ('BUFFERING_OUT_STATE', 9),
-           ('PROVENANCE_DATA', 10)])
+           ('PROVENANCE_DATA', 10),
+           ('PLASTIC_WEIGHTS', 11)])
@@ -0,0 +1,60 @@
+import unittest
+import struct
+import numpy
+from spynnaker.pyNN.models.common.spike_recorder import decode_spike_records
+
+
+def _bit_field_record(time, neuron_ids, n_words):
+    bit_field = [0] * n_words
+    for neuron_id in neuron_ids:
+        bit_field[neuron_id / 32] |= 1 << (neuron_id % 32)
+    return struct.pack("<{}I".format(n_words + 2), time, n_words, *bit_field)
+
+
+def _index_record(time, neuron_ids):
+    indices = sorted(neuron_ids)
+    header = struct.pack("<II", time, 0x80000000 | len(indices))
+    if len(indices) % 2 == 1:
+        indices.append(0)
+    return header + struct.pack("<{}H".format(len(indices)), *indices)
+
+
+class TestSpikeRecorder(unittest.TestCase):
+
+    def test_decode_mixed_records(self):
+        n_words = 4
+        raw = (_index_record(3, [5, 100]) +
+               _bit_field_record(4, range(0, 128, 3), n_words) +
+               _index_record(7, [127]))
+        times, ids = decode_spike_records(bytearray(raw), n_words)
+        result = sorted(zip(times.tolist(), ids.tolist()))
+        expected = sorted(
+            [(3, 5), (3, 100), (7, 127)] +
+            [(4, i) for i in range(0, 128, 3)])
+        self.assertEqual(result, expected)
+
+    def test_decode_empty(self):
+        times, ids = decode_spike_records(bytearray(), 1)
+        self.assertEqual(len(times), 0)
+        self.assertEqual(len(ids), 0)
+
+    def test_decode_matches_full_bit_field(self):
+        n_words = 8
+        rng = numpy.random.RandomState(1)
+        raw = ""
+        expected = list()
+        for time in range(100):
+            neuron_ids = [int(i) for i in rng.choice(
+                n_words * 32, rng.randint(1, 40), replace=False)]
+            expected.extend((time, i) for i in neuron_ids)
+            if len(neuron_ids) < n_words * 2:
+                raw += _index_record(time, neuron_ids)
+            else:
+                raw += _bit_field_record(time, neuron_ids, n_words)
+        times, ids = decode_spike_records(bytearray(raw), n_words)
+        self.assertEqual(
+            sorted(zip(times.tolist(), ids.tolist())), sorted(expected))
+
+
+if __name__ == '__main__':
+    unittest.main()
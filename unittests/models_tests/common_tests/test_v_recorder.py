@@ -0,0 +1,54 @@
+import unittest
+import struct
+import numpy
+from spynnaker.pyNN.models.common.v_recorder import decode_compressed_v, \
+    VRecorder, NO_V_COMPRESSION
+
+
+class TestVRecorder(unittest.TestCase):
+
+    def test_decode_compressed_v(self):
+        n_atoms = 3
+        shift = 8
+        baseline = -65 * 32767
+        deltas = [0, 10, 0xFFFF]
+        raw = (struct.pack("<Ii", 12, baseline) +
+               struct.pack("<4H", *(deltas + [0])))
+        times, voltages = decode_compressed_v(bytearray(raw), n_atoms, shift)
+        self.assertEqual(times.tolist(), [[12]])
+        expected = [(baseline + (d << shift)) / 32767.0 for d in deltas]
+        self.assertTrue(numpy.allclose(voltages[0], expected))
+
+    def test_decode_compressed_v_precision(self):
+        n_atoms = 4
+        shift = 8
+        rng = numpy.random.RandomState(2)
+        voltages = rng.uniform(-70.0, -50.0, n_atoms)
+        fixed = (voltages * 32767.0).astype("int32")
+        baseline = fixed.min()
+        deltas = [int(d) >> shift for d in fixed - baseline]
+        raw = (struct.pack("<Ii", 0, baseline) +
+               struct.pack("<4H", *deltas))
+        _, decoded = decode_compressed_v(bytearray(raw), n_atoms, shift)
+        resolution = (1 << shift) / 32767.0
+        self.assertTrue(numpy.all(numpy.abs(decoded[0] - voltages) <
+                                  resolution + (1 / 32767.0)))
+
+    def test_dtcm_usage(self):
+        recorder = VRecorder(1000, 8)
+        self.assertEqual(recorder.get_dtcm_usage_in_bytes(5), 0)
+        self.assertEqual(recorder.compression_shift, NO_V_COMPRESSION)
+        recorder.record_v = True
+        self.assertEqual(recorder.compression_shift, 8)
+
+        # The 4 bytes of any recording, and the time, the baseline and
+        # three words of deltas of the compressed record
+        self.assertEqual(recorder.get_dtcm_usage_in_bytes(5), 24)
+        recorder = VRecorder(1000)
+        recorder.record_v = True
+        self.assertEqual(recorder.get_dtcm_usage_in_bytes(5), 4)
+        self.assertEqual(recorder.compression_shift, NO_V_COMPRESSION)
+
+
+if __name__ == '__main__':
+    unittest.main()
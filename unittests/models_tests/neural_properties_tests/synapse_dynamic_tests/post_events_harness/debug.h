@@ -0,0 +1,14 @@
+// Host stand-in for the SpiNNaker debug header, so that post_events.h can be
+// built on the host by test_post_event_history.py
+#ifndef _DEBUG_H_
+#define _DEBUG_H_
+
+#include <stdio.h>
+
+#define log_info(...) do {} while (0)
+#define log_debug(...) do {} while (0)
+#define log_error(...) do { \
+        fprintf(stderr, __VA_ARGS__); fprintf(stderr, "\n"); \
+    } while (0)
+
+#endif  // _DEBUG_H_
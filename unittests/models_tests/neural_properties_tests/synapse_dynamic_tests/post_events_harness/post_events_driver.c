@@ -0,0 +1,106 @@
+// Runs deferred pair STDP over recorded pre- and post-synaptic spike trains
+// using whichever post_events.h is first on the include path, printing each
+// window read from the history and the final weight.  Built on the host by
+// test_post_event_history.py against both the shuffle-down history that the
+// binaries used to have and the current circular history.
+//
+// Input: the number of pre-synaptic spikes, their times, the number of
+// post-synaptic spikes and their times, all in time steps and increasing.
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define spin1_malloc malloc
+
+#define TAU 20.0
+#define HISTORY_SIZE 16
+
+typedef int32_t post_trace_t;
+
+static inline post_trace_t timing_get_initial_post_trace() {
+    return 0;
+}
+
+#include "post_events.h"
+
+static uint32_t *read_train(uint32_t *n_spikes) {
+    if (scanf("%u", n_spikes) != 1) {
+        return NULL;
+    }
+    uint32_t *times = malloc((*n_spikes + 1) * sizeof(uint32_t));
+    for (uint32_t i = 0; i < *n_spikes; i++) {
+        if (scanf("%u", &times[i]) != 1) {
+            return NULL;
+        }
+    }
+    return times;
+}
+
+static inline post_trace_t decay_trace(post_trace_t trace, uint32_t dt) {
+    return (post_trace_t) (trace * exp(-(double) dt / TAU));
+}
+
+int main() {
+    uint32_t n_pre, n_post;
+    uint32_t *pre_times = read_train(&n_pre);
+    uint32_t *post_times = read_train(&n_post);
+    if (pre_times == NULL || post_times == NULL) {
+        fprintf(stderr, "Invalid spike trains\n");
+        return 1;
+    }
+
+#ifdef SHUFFLE_DOWN_HISTORY
+    post_event_history_t *history = post_events_init_buffers(1);
+#else
+    post_event_history_t *history = post_events_init_buffers(1, HISTORY_SIZE);
+#endif
+    if (history == NULL) {
+        return 1;
+    }
+
+    double weight = 0.0;
+    uint32_t last_pre_time = 0;
+    post_trace_t last_pre_trace = 0;
+    uint32_t last_post_time = 0;
+    post_trace_t last_post_trace = timing_get_initial_post_trace();
+    uint32_t post = 0;
+    for (uint32_t pre = 0; pre < n_pre; pre++) {
+        uint32_t time = pre_times[pre];
+
+        // Add the post-synaptic spikes up to this time step
+        for (; post < n_post && post_times[post] <= time; post++) {
+            last_post_trace = decay_trace(
+                last_post_trace, post_times[post] - last_post_time) + 2048;
+            last_post_time = post_times[post];
+            post_events_add(last_post_time, history, last_post_trace);
+        }
+
+        // Potentiate for each post-synaptic spike since the last
+        // pre-synaptic spike, then depress for this one
+        post_event_window_t window = post_events_get_window_delayed(
+            history, last_pre_time, time);
+        printf("%u %d", window.prev_time, window.prev_trace);
+        while (window.num_events > 0) {
+#ifdef SHUFFLE_DOWN_HISTORY
+            uint32_t post_time = *window.next_time;
+            post_trace_t post_trace = *window.next_trace;
+#else
+            uint32_t post_time = window.next_time;
+            post_trace_t post_trace = window.next_trace;
+#endif
+            printf(" %u %d", post_time, post_trace);
+            weight += decay_trace(last_pre_trace, post_time - last_pre_time);
+            window = post_events_next_delayed(window, post_time);
+        }
+        printf("\n");
+        weight -= decay_trace(window.prev_trace, time - window.prev_time);
+
+        last_pre_trace = decay_trace(
+            last_pre_trace, time - last_pre_time) + 2048;
+        last_pre_time = time;
+    }
+    printf("%.17g\n", weight);
+    return 0;
+}
@@ -0,0 +1,119 @@
+"""
+Tests of the exponential decay lookup tables of the STDP timing rules, and of
+the words describing them which are read by maths_read_exp_luts
+(neural_modelling/src/neuron/plasticity/common/maths.h).
+"""
+import math
+import unittest
+
+import numpy
+
+from spynnaker.pyNN.models.neuron.plasticity.stdp.common \
+    import plasticity_helpers
+
+_ONE = plasticity_helpers.STDP_FIXED_POINT_ONE
+
+
+class _Spec(object):
+    """ Records the values and arrays written to a region
+    """
+
+    def __init__(self):
+        self.words = list()
+        self.descriptions = list()
+
+    def write_value(self, data, data_type=None):
+        self.descriptions.append(len(self.words))
+        self.words.append(data)
+
+    def write_array(self, array_values, data_type=None):
+        self.words.extend(array_values)
+
+
+class TestPlasticityHelpers(unittest.TestCase):
+
+    def test_lut_size_and_shift(self):
+
+        # 20ms decays to less than half of the smallest value after 167 time
+        # steps, so the table has an entry for each time up to that
+        self.assertEqual(
+            plasticity_helpers.get_exp_lut_size_and_shift(20.0), (168, 0))
+
+        # 200ms takes 1664 time steps, which only fits in 256 entries with
+        # an entry every 8 time steps
+        self.assertEqual(
+            plasticity_helpers.get_exp_lut_size_and_shift(200.0), (209, 3))
+
+    def test_lut_cap(self):
+        for time_constant in [1.0, 10.0, 20.0, 30.5, 100.0, 1000.0, 5000.0]:
+            size, shift = plasticity_helpers.get_exp_lut_size_and_shift(
+                time_constant)
+            self.assertLessEqual(size, plasticity_helpers.MAX_EXP_LUT_SIZE)
+
+            # The table reaches the time at which the decay rounds to zero,
+            # with the smallest shift that fits
+            end_time = int(math.floor(
+                time_constant * math.log(2.0 * _ONE))) + 1
+            self.assertGreaterEqual((size - 1) << shift, end_time)
+            if shift > 0:
+                self.assertGreater(
+                    int(math.ceil(float(end_time) / (1 << (shift - 1)))) + 1,
+                    plasticity_helpers.MAX_EXP_LUT_SIZE)
+
+        # A smaller maximum forces a coarser table
+        self.assertEqual(
+            plasticity_helpers.get_exp_lut_size_and_shift(20.0, max_size=64),
+            (43, 2))
+
+    def test_last_entry_zero(self):
+        luts = plasticity_helpers.get_exp_luts(
+            [1.0, 10.0, 20.0, 30.5, 100.0, 1000.0, 5000.0])
+        for (size, shift, entries, _) in luts:
+            self.assertEqual(len(entries), size)
+            self.assertEqual(entries[0], _ONE)
+            self.assertEqual(entries[-1], 0)
+            self.assertGreater(entries[-2], 0)
+            self.assertTrue(numpy.all(numpy.diff(entries) <= 0))
+
+    def test_shared_luts(self):
+        luts = plasticity_helpers.get_exp_luts([20.0, 30.0, 20.0, 30.0])
+        self.assertEqual(
+            [shared for (_, _, _, shared) in luts], [None, None, 0, 1])
+
+    def test_write_luts(self):
+        luts = plasticity_helpers.get_exp_luts([20.0, 200.0, 20.0])
+        spec = _Spec()
+        last_entries = plasticity_helpers.write_exp_luts(
+            spec, luts, interpolate=True)
+        self.assertEqual(last_entries, [0.0, 0.0, 0.0])
+        self.assertEqual(
+            len(spec.words) * 4,
+            plasticity_helpers.get_exp_luts_sdram_usage_in_bytes(luts))
+
+        # The size is in bits 0 to 15, the shift in bits 16 to 20, the
+        # interpolate flag (only set when the shift is not 0) in bit 21 and
+        # one more than the index of a shared table from bit 24
+        self.assertEqual(
+            [spec.words[i] for i in spec.descriptions],
+            [168, 209 | (3 << 16) | (1 << 21), 168 | (1 << 24)])
+
+        # The entries of each unshared table are packed two to a word
+        first, second, _ = spec.descriptions
+        self.assertEqual(second - first - 1, 84)
+        entries = numpy.array(
+            spec.words[first + 1:second], dtype="uint32").view("int16")
+        self.assertTrue(numpy.array_equal(entries, luts[0][2]))
+        entries = numpy.array(
+            spec.words[second + 1:second + 106], dtype="uint32").view("int16")
+        self.assertTrue(numpy.array_equal(entries[:209], luts[1][2]))
+        self.assertEqual(entries[209], 0)
+
+    def test_write_luts_without_interpolation(self):
+        luts = plasticity_helpers.get_exp_luts([200.0])
+        spec = _Spec()
+        plasticity_helpers.write_exp_luts(spec, luts)
+        self.assertEqual(spec.words[0], 209 | (3 << 16))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,107 @@
+"""
+Checks that the circular post-synaptic event history of the STDP binaries
+(neural_modelling/src/neuron/plasticity/common/post_events.h) gives the same
+windows, and so the same STDP results, as the shuffle-down history it
+replaced.  post_events_harness/post_events_driver.c is built on the host
+against each version of the header, and both are run on the same recorded
+spike trains.
+"""
+from distutils.spawn import find_executable
+import os
+import shutil
+import subprocess
+import tempfile
+import unittest
+
+import numpy
+
+_HARNESS = os.path.join(os.path.dirname(__file__), "post_events_harness")
+_POST_EVENTS = os.path.join(
+    os.path.dirname(__file__), "..", "..", "..", "..", "neural_modelling",
+    "src", "neuron", "plasticity", "common")
+
+
+def _poisson_train(rng, rate, duration):
+    """ A spike train in whole time steps of 1ms, with at most one spike in\
+        each time step
+    """
+    times = numpy.cumsum(rng.exponential(1000.0 / rate, int(rate * duration)))
+    return numpy.unique(numpy.floor(times[times < duration * 1000.0]) + 1)
+
+
+def _bursting_train(rng, n_bursts, burst_length, duration):
+    """ A spike train of bursts of spikes on consecutive time steps, long\
+        enough to fill the history
+    """
+    starts = numpy.sort(rng.randint(1, duration * 1000, n_bursts))
+    return numpy.unique(numpy.concatenate(
+        [numpy.arange(start, start + burst_length) for start in starts]))
+
+
+@unittest.skipIf(find_executable("gcc") is None, "gcc is not available")
+class TestPostEventHistory(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        cls._build_dir = tempfile.mkdtemp()
+        driver = os.path.join(_HARNESS, "post_events_driver.c")
+        cls._shuffle_down = cls._build(
+            "shuffle_down", driver, os.path.join(_HARNESS, "shuffle_down"),
+            ["-DSHUFFLE_DOWN_HISTORY"])
+        cls._circular = cls._build("circular", driver, _POST_EVENTS, [])
+        cls._compressed = cls._build(
+            "compressed", driver, _POST_EVENTS,
+            ["-DPOST_EVENT_TIMES_COMPRESSED"])
+
+    @classmethod
+    def tearDownClass(cls):
+        shutil.rmtree(cls._build_dir)
+
+    @classmethod
+    def _build(cls, name, driver, header_dir, flags):
+        executable = os.path.join(cls._build_dir, name)
+        subprocess.check_call(
+            ["gcc", "-std=gnu99", "-O1", "-o", executable, driver,
+             "-I", header_dir, "-I", _HARNESS] + flags + ["-lm"])
+        return executable
+
+    @staticmethod
+    def _run(executable, pre_times, post_times):
+        trains = "{} {}\n{} {}\n".format(
+            len(pre_times), " ".join(str(int(t)) for t in pre_times),
+            len(post_times), " ".join(str(int(t)) for t in post_times))
+        process = subprocess.Popen(
+            [executable], stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+        output, _ = process.communicate(trains.encode("ascii"))
+        if process.returncode != 0:
+            raise Exception("{} failed".format(executable))
+        return output.decode("ascii").splitlines()
+
+    def _check_same(self, pre_times, post_times):
+        expected = self._run(self._shuffle_down, pre_times, post_times)
+        self.assertEqual(len(expected), len(pre_times) + 1)
+        for executable in (self._circular, self._compressed):
+            self.assertEqual(
+                self._run(executable, pre_times, post_times), expected)
+        return expected
+
+    def test_poisson_trains(self):
+        rng = numpy.random.RandomState(42)
+        for pre_rate, post_rate in [(10, 10), (5, 80), (50, 5), (20, 200)]:
+            self._check_same(
+                _poisson_train(rng, pre_rate, 10.0),
+                _poisson_train(rng, post_rate, 10.0))
+
+    def test_bursting_post_neuron(self):
+
+        # Bursts longer than the history wrap it around between most
+        # pre-synaptic spikes
+        rng = numpy.random.RandomState(7)
+        output = self._check_same(
+            _poisson_train(rng, 5, 20.0), _bursting_train(rng, 40, 30, 20.0))
+        self.assertTrue(any(
+            len(line.split()) == 2 + (2 * 15) for line in output[:-1]))
+
+
+if __name__ == '__main__':
+    unittest.main()
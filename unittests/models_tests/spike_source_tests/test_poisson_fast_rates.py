@@ -0,0 +1,186 @@
+"""
+Tests of the tables of the cumulative distribution generated for the fast
+rates of the Poisson spike source, and of the fast rate region in which they
+are written for the binary
+(neural_modelling/src/spike_source/poisson/spike_source_poisson.c).
+"""
+import math
+import struct
+import unittest
+
+from spynnaker.pyNN.models.spike_source.spike_source_poisson \
+    import SpikeSourcePoisson, get_poisson_cdf_table
+from spynnaker.pyNN.models.spike_source\
+    .spike_source_poisson_partitioned_vertex \
+    import SpikeSourcePoissonPartitionedVertex
+
+_INVERSE_CDF = 1
+_NORMAL = 2
+
+
+class _Slice(object):
+
+    def __init__(self, lo_atom, hi_atom):
+        self.lo_atom = lo_atom
+        self.hi_atom = hi_atom
+        self.n_atoms = hi_atom - lo_atom + 1
+
+
+class _Spec(object):
+    """ Records the values written to a region
+    """
+
+    def __init__(self):
+        self.region = None
+        self.values = list()
+
+    def switch_write_focus(self, region):
+        self.region = region
+
+    def write_value(self, data, data_type=None):
+        self.values.append(data)
+
+
+def _poisson_cdf(lambda_val, n_values):
+    """ P(X <= k) for k in 0 to n_values - 1
+    """
+    log_probability = -lambda_val
+    cdf = list()
+    cumulative = 0.0
+    for k in range(n_values):
+        cumulative += math.exp(log_probability)
+        cdf.append(cumulative)
+        log_probability += math.log(lambda_val) - math.log(k + 1)
+    return cdf
+
+
+def _source(source_rates, cdf_table_dtcm_bytes, normal_lambda=0):
+    """ A Poisson source with just what is needed for its fast rates, with a\
+        time step of 1ms, so that lambda is the rate in kHz
+    """
+    source = SpikeSourcePoisson.__new__(SpikeSourcePoisson)
+    source._source_rates = source_rates
+    source._machine_time_step = 1000
+    source._cdf_table_dtcm_bytes = cdf_table_dtcm_bytes
+    source._fast_method = "inverse_cdf"
+    source._normal_lambda = normal_lambda
+    return source
+
+
+class TestPoissonFastRates(unittest.TestCase):
+
+    def test_cdf_tables(self):
+        for lambda_val in [1.5, 5.0, 20.0, 100.0]:
+            table = get_poisson_cdf_table(lambda_val, 1024)
+            self.assertEqual(table[-1], 0xFFFFFFFF)
+            self.assertTrue(all(
+                a <= b for a, b in zip(table[:-1], table[1:])))
+            cdf = _poisson_cdf(lambda_val, len(table))
+            for entry, probability in zip(table[:-1], cdf[:-1]):
+                self.assertEqual(entry, int(probability * 2.0 ** 32))
+
+            # Less than 2^-32 of the probability is beyond the table
+            self.assertLess(1.0 - cdf[-1], 2.0 ** -32)
+            self.assertGreaterEqual(1.0 - cdf[-2], 2.0 ** -32)
+            self.assertIsNone(
+                get_poisson_cdf_table(lambda_val, len(table) - 1))
+
+        # Rates whose exp(-lambda) underflows do not get a table
+        self.assertIsNone(get_poisson_cdf_table(1000.0, 2048))
+
+    def test_fast_rates(self):
+
+        # Slow and zero rates are left out, and the rates of the slice and
+        # of the schedule are shared
+        source = _source([5000.0, 1500.0, 0.0, 1500.0, 500.0, 1500.0], 8192)
+        fast_rates = source._get_fast_rates(
+            _Slice(1, 5), [(10, 0, 2, 20000.0), (20, 3, 1, 1500.0)])
+        self.assertEqual(
+            [(method, lambda_val) for (_, method, lambda_val, _) in
+             fast_rates],
+            [(_INVERSE_CDF, 1.5), (_INVERSE_CDF, 20.0)])
+
+        # The rates are in order of lambda, and the tables of the most used
+        # rates come first in the budget
+        budget = 8192 / 4
+        words = list()
+        for (word, _, lambda_val, table) in fast_rates:
+            self.assertEqual(word, int(round(lambda_val * 32768.0)))
+            self.assertEqual(table, get_poisson_cdf_table(lambda_val, budget))
+            budget -= len(table)
+            words.append(word)
+        self.assertEqual(words, sorted(words))
+
+    def test_high_rates(self):
+
+        # exp(-lambda) is 0 in 32 bits for lambda above about 22, so the
+        # rates are told apart by lambda, and each gets its own table
+        self.assertEqual(int(round(math.exp(-30.0) * 2.0 ** 32)), 0)
+        source = _source([30000.0, 40000.0, 30000.0], 8192)
+        fast_rates = source._get_fast_rates(_Slice(0, 2), [])
+        self.assertEqual(
+            [(method, lambda_val) for (_, method, lambda_val, _) in
+             fast_rates],
+            [(_INVERSE_CDF, 30.0), (_INVERSE_CDF, 40.0)])
+        for (_, _, lambda_val, table) in fast_rates:
+            self.assertEqual(table, get_poisson_cdf_table(lambda_val, 2048))
+
+        # The rate updates sent to the machine carry the same lambda
+        update = struct.unpack(
+            "<IIiiI", source._pack_rate_update(0, 1, 40000.0))
+        self.assertEqual(update[2:], (0, fast_rates[1][0], 0))
+
+    def test_table_budget(self):
+
+        # A rate whose table does not fit is left out, and so multiplies
+        table_words = len(get_poisson_cdf_table(1.5, 1024))
+        source = _source([1500.0, 1500.0, 20000.0], table_words * 4)
+        fast_rates = source._get_fast_rates(_Slice(0, 2), [])
+        self.assertEqual(
+            [(method, lambda_val) for (_, method, lambda_val, _) in
+             fast_rates],
+            [(_INVERSE_CDF, 1.5)])
+
+    def test_normal_rates(self):
+        source = _source(
+            [1500.0, 30000.0, 40000.0, 30000.0], 0, normal_lambda=25.0)
+        fast_rates = source._get_fast_rates(_Slice(0, 3), [])
+        self.assertEqual(
+            [(method, lambda_val, table) for (_, method, lambda_val, table)
+             in fast_rates],
+            [(_NORMAL, 30.0, []), (_NORMAL, 40.0, [])])
+
+    def test_write_fast_rates(self):
+        source = _source([1500.0, 30000.0, 2000.0], 8192, normal_lambda=25.0)
+        fast_rates = source._get_fast_rates(_Slice(0, 2), [])
+        spec = _Spec()
+        source._write_fast_rates(spec, fast_rates)
+        self.assertEqual(
+            spec.region,
+            SpikeSourcePoissonPartitionedVertex.
+            _POISSON_SPIKE_SOURCE_REGIONS.FAST_RATE_REGION.value)
+
+        # The header has the number of rates and the number of words of the
+        # rates, then each rate is the method, lambda and sqrt(lambda) in
+        # s1615, and the table preceded by its length
+        values = spec.values
+        self.assertEqual(values[0], 3)
+        self.assertEqual(values[1], len(values) - 2)
+        position = 2
+        for (word, method, lambda_val, table) in fast_rates:
+            self.assertEqual(
+                values[position:position + 4],
+                [method, int(round(lambda_val * 32768.0)),
+                 int(round(math.sqrt(lambda_val) * 32768.0)), len(table)])
+            self.assertEqual(word, values[position + 1])
+            position += 4
+            self.assertEqual(values[position:position + len(table)], table)
+            position += len(table)
+        self.assertEqual(position, len(values))
+        self.assertEqual(
+            [method for (_, method, _, _) in fast_rates],
+            [_INVERSE_CDF, _INVERSE_CDF, _NORMAL])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,213 @@
+"""
+Tests of the handshake by which the host changes the rates of Poisson spike
+sources on the machine: the host writes the updates and then a new sequence
+number into the rate update region, and the core
+(neural_modelling/src/spike_source/poisson/spike_source_poisson.c) applies
+them at its next timer tick or when resumed, and writes the sequence number
+back as acknowledged.
+"""
+import struct
+import unittest
+
+import numpy
+
+from spynnaker.pyNN import exceptions
+from spynnaker.pyNN.models.spike_source.spike_source_poisson \
+    import SpikeSourcePoisson
+
+# The rate update region of the core on processor p is at p times this
+_REGION_SPACING = 0x1000
+
+
+class _Slice(object):
+
+    def __init__(self, lo_atom, hi_atom):
+        self.lo_atom = lo_atom
+        self.hi_atom = hi_atom
+        self.n_atoms = hi_atom - lo_atom + 1
+
+
+class _Placement(object):
+
+    def __init__(self, p):
+        self.x = 0
+        self.y = 0
+        self.p = p
+
+
+class _Mapping(object):
+    """ The graph mapper and placements of a source split into slices, each\
+        on its own core
+    """
+
+    def __init__(self, slices):
+        self._subvertices = [
+            (str(i), vertex_slice, _Placement(i + 1))
+            for i, vertex_slice in enumerate(slices)]
+
+    def get_subvertices_from_vertex(self, vertex):
+        return [subvertex for (subvertex, _, _) in self._subvertices]
+
+    def get_subvertex_slice(self, subvertex):
+        return self._subvertices[int(subvertex)][1]
+
+    def get_placement_of_subvertex(self, subvertex):
+        return self._subvertices[int(subvertex)][2]
+
+
+class _Core(object):
+    """ The rate update region of a core, and the rates it has applied
+    """
+
+    def __init__(self, n_atoms, running=True):
+        self.region = bytearray(12 + (20 * n_atoms))
+        self.rates = dict()
+        self.running = running
+
+    def apply(self):
+        """ What the core does at each timer tick and when resumed
+        """
+        sequence, acknowledged, n_updates = struct.unpack_from(
+            "<III", buffer(self.region))
+        if sequence == acknowledged:
+            return
+        for u in range(n_updates):
+            first_id, n_ids, isi, lambda_val, exp_minus_lambda = \
+                struct.unpack_from(
+                    "<IIiiI", buffer(self.region), 12 + (20 * u))
+            for neuron_id in range(first_id, first_id + n_ids):
+                self.rates[neuron_id] = (isi, lambda_val, exp_minus_lambda)
+        struct.pack_into("<I", self.region, 4, sequence)
+
+
+class _Machine(object):
+    """ A transceiver to the rate update regions of a number of cores
+    """
+
+    def __init__(self, cores):
+        self._cores = cores
+
+    def read_memory(self, x, y, address, length):
+
+        # A running core may pick up an update at any time
+        core = self._cores[address // _REGION_SPACING]
+        if core.running:
+            core.apply()
+        offset = address % _REGION_SPACING
+        return core.region[offset:offset + length]
+
+    def write_memory(self, x, y, address, data):
+        core = self._cores[address // _REGION_SPACING]
+        offset = address % _REGION_SPACING
+        core.region[offset:offset + len(data)] = data
+
+
+class _Source(SpikeSourcePoisson):
+    """ A Poisson source with just what is needed to update its rates, with a\
+        time step of 1ms
+    """
+
+    def __init__(self, rates, max_rates):
+        self._label = "source"
+        self._rate = numpy.array(rates)
+        self._source_rates = numpy.array(rates)
+        self._rate_schedule = None
+        self._machine_time_step = 1000
+        self._timescale_factor = 1
+        self._rate_update_sequences = dict()
+        self._pending_rate_updates = dict()
+        self._mapped_max_rates = dict()
+        for p, max_rate in enumerate(max_rates):
+            self._rate_update_sequences[(0, 0, p + 1)] = 0
+            self._mapped_max_rates[(0, 0, p + 1)] = max_rate
+
+    @staticmethod
+    def _get_rate_update_address(transceiver, placement):
+        return placement.p * _REGION_SPACING
+
+
+class TestPoissonRateUpdates(unittest.TestCase):
+
+    def setUp(self):
+        self._mapping = _Mapping([_Slice(0, 3), _Slice(4, 7)])
+        self._cores = {1: _Core(4), 2: _Core(4)}
+        self._machine = _Machine(self._cores)
+        self._source = _Source([1.0] * 8, [50.0, 50.0])
+
+    def _update(self, rate, neuron_ids, wait=False):
+        self._source.update_rates_on_machine(
+            rate, neuron_ids, self._machine, self._mapping, self._mapping,
+            wait)
+
+    def _expected(self, rates):
+        return {
+            neuron_id: struct.unpack(
+                "<IIiiI", self._source._pack_rate_update(0, 1, rate_val))[2:]
+            for neuron_id, rate_val in rates.items()}
+
+    def _header(self, p):
+        return struct.unpack_from("<III", buffer(self._cores[p].region))
+
+    def test_running(self):
+
+        # The core applies the updates and acknowledges each sequence number
+        self._update([10.0, 20.0, 20.0], [1, 5, 6], wait=True)
+        self.assertEqual(self._header(1)[:2], (1, 1))
+        self.assertEqual(self._header(2)[:2], (1, 1))
+        self.assertEqual(self._cores[1].rates, self._expected({1: 10.0}))
+        self.assertEqual(
+            self._cores[2].rates, self._expected({1: 20.0, 2: 20.0}))
+
+        # Once acknowledged, the next update only has the new rates
+        self._update(5.0, [0], wait=True)
+        self.assertEqual(self._header(1), (2, 2, 1))
+        self.assertEqual(self._header(2)[:2], (1, 1))
+        self.assertEqual(
+            self._cores[1].rates, self._expected({0: 5.0, 1: 10.0}))
+        self.assertEqual(
+            list(self._source._rate),
+            [5.0, 10.0, 1.0, 1.0, 1.0, 20.0, 20.0, 1.0])
+
+    def test_paused(self):
+        for core in self._cores.values():
+            core.running = False
+
+        # Updates made while paused do not wait, and are merged into the
+        # one the core has not yet acknowledged, the last rate winning
+        self._update(10.0, [0, 1, 2])
+        self._update([20.0, 30.0], [2, 3])
+        self._update(40.0, [0])
+        self.assertEqual(self._header(1), (3, 0, 4))
+        self.assertEqual(self._header(2)[:2], (0, 0))
+        self.assertEqual(
+            list(self._source._rate),
+            [40.0, 10.0, 20.0, 30.0, 1.0, 1.0, 1.0, 1.0])
+
+        # The core picks all of them up when resumed
+        self._cores[1].apply()
+        self.assertEqual(self._header(1)[:2], (3, 3))
+        self.assertEqual(self._cores[1].rates, self._expected(
+            {0: 40.0, 1: 10.0, 2: 20.0, 3: 30.0}))
+
+        # Waiting while paused fails, but the rates are still sent
+        self._cores[1].running = False
+        with self.assertRaises(exceptions.SpynnakerException):
+            self._update(5.0, [3], wait=True)
+        self.assertEqual(self._source._rate[3], 5.0)
+        self.assertEqual(self._header(1), (4, 3, 1))
+
+    def test_mapped_max_rate(self):
+
+        # A rate above what the core was mapped for is refused before any
+        # core is updated, even after the rates have been lowered
+        self._update(1.0, range(8))
+        self._update(50.0, [0])
+        with self.assertRaises(exceptions.SpynnakerException):
+            self._update([1.0, 60.0], [0, 4])
+        self.assertEqual(self._header(1)[0], 2)
+        self.assertEqual(self._header(2)[0], 1)
+        self.assertEqual(self._source._rate[0], 50.0)
+
+
+if __name__ == '__main__':
+    unittest.main()
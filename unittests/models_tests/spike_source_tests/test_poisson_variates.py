@@ -0,0 +1,120 @@
+"""
+Kolmogorov-Smirnov tests of the ways the Poisson spike source binary
+(neural_modelling/src/spike_source/poisson/spike_source_poisson.c) draws the
+number of spikes of a fast source in a time step.  Each method is modelled
+here in the same way as the C code, from the values written to the fast rate
+region, and the distribution of its draws is compared with the Poisson
+distribution.
+"""
+import math
+import unittest
+
+import numpy
+
+from spynnaker.pyNN.models.spike_source.spike_source_poisson \
+    import get_poisson_cdf_table
+
+N_DRAWS = 20000
+
+# The critical value of the statistic for N_DRAWS draws at the 0.1% level;
+# this is conservative for discrete distributions
+KS_CRITICAL = 1.95 / math.sqrt(N_DRAWS)
+
+# The documented largest difference between the cumulative distributions of
+# the normal approximation and the Poisson distribution, times sqrt(lambda)
+NORMAL_DIFFERENCE = 0.067
+
+
+def _poisson_cdf(lambda_val, n_values):
+    """ P(X <= k) for k in 0 to n_values - 1
+    """
+    log_probability = -lambda_val
+    cdf = numpy.zeros(n_values)
+    cumulative = 0.0
+    for k in range(n_values):
+        cumulative += math.exp(log_probability)
+        cdf[k] = cumulative
+        log_probability += math.log(lambda_val) - math.log(k + 1)
+    return cdf
+
+
+def _s1615(value):
+    """ A value as it is held in an accum on the machine
+    """
+    return int(round(value * 32768.0)) / 32768.0
+
+
+def _inverse_cdf_variates(rng, table):
+    """ The first k with u < table[k] for a 32-bit uniform u, searching all\
+        but the last entry, which takes all larger values
+    """
+    u = rng.randint(0, 2 ** 32, N_DRAWS, dtype="uint64")
+    variates = numpy.zeros(N_DRAWS, dtype="int64")
+    for i in range(N_DRAWS):
+        lo = 0
+        hi = len(table) - 1
+        while lo < hi:
+            mid = (lo + hi) >> 1
+            if u[i] < table[mid]:
+                hi = mid
+            else:
+                lo = mid + 1
+        variates[i] = lo
+    return variates
+
+
+def _normal_variates(rng, lambda_val):
+    """ floor(lambda + 0.5 + sqrt(lambda) * z) for a standard normal z,\
+        with lambda and sqrt(lambda) in s1615, or 0 if it is negative
+    """
+    spikes = _s1615(lambda_val) + 0.5 + (
+        _s1615(math.sqrt(lambda_val)) * rng.standard_normal(N_DRAWS))
+    spikes[spikes < 0.0] = 0.0
+    return numpy.floor(spikes).astype("int64")
+
+
+def _ks_statistic(variates, lambda_val):
+    """ The largest difference between the empirical and Poisson cumulative\
+        distributions
+    """
+    n_values = int(max(variates.max() + 1, lambda_val * 2 + 20))
+    empirical = numpy.cumsum(
+        numpy.bincount(variates, minlength=n_values)) / float(len(variates))
+    return numpy.abs(empirical - _poisson_cdf(lambda_val, n_values)).max()
+
+
+class TestPoissonVariates(unittest.TestCase):
+
+    def test_inverse_cdf(self):
+        rng = numpy.random.RandomState(42)
+        for lambda_val in [1.5, 5.0, 20.0, 30.0, 100.0]:
+            variates = _inverse_cdf_variates(
+                rng, get_poisson_cdf_table(lambda_val, 1024))
+            self.assertLess(_ks_statistic(variates, lambda_val), KS_CRITICAL)
+
+    def test_normal_approximation(self):
+        rng = numpy.random.RandomState(42)
+        for lambda_val in [25.0, 30.0, 100.0, 400.0]:
+            variates = _normal_variates(rng, lambda_val)
+            self.assertLess(
+                _ks_statistic(variates, lambda_val),
+                (NORMAL_DIFFERENCE / math.sqrt(lambda_val)) + KS_CRITICAL)
+
+    def test_normal_approximation_error(self):
+
+        # The rounded normal distribution itself is within the bound of the
+        # Poisson distribution, so the test above has room for sampling
+        for lambda_val in [25.0, 30.0, 100.0, 400.0]:
+            n_values = int(lambda_val * 2 + 20)
+            sigma = _s1615(math.sqrt(lambda_val))
+            normal = numpy.array([
+                0.5 * math.erfc(
+                    -(k + 0.5 - _s1615(lambda_val)) / (sigma * math.sqrt(2.0)))
+                for k in range(n_values)])
+            self.assertLess(
+                numpy.abs(normal - _poisson_cdf(lambda_val, n_values)).max(),
+                NORMAL_DIFFERENCE / math.sqrt(lambda_val))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,89 @@
+"""
+Tests of the compression of the spikes played back by the spike source array
+binary (neural_modelling/src/spike_source/array/spike_source_array.c).  The
+stream is decoded here in the same way as the C code.
+"""
+import math
+import unittest
+
+import numpy
+
+from spynnaker.pyNN.models.spike_source.spike_source_array \
+    import compress_spike_times, get_compressed_spike_times_size
+
+
+class _Slice(object):
+
+    def __init__(self, lo_atom, hi_atom):
+        self.lo_atom = lo_atom
+        self.hi_atom = hi_atom
+        self.n_atoms = hi_atom - lo_atom + 1
+
+
+def _decode(stream):
+    """ Decode a stream into a list of (time step, index) of each spike
+    """
+    position = [0]
+
+    def read_value():
+        value = 0
+        shift = 0
+        while True:
+            halfword = int(stream[position[0]])
+            position[0] += 1
+            value |= (halfword & 0x7FFF) << shift
+            shift += 15
+            if not halfword & 0x8000:
+                return value
+
+    spikes = list()
+    tick = 0
+    while position[0] < len(stream):
+        tick += read_value()
+        index = 0
+        for _ in range(read_value()):
+            index += read_value()
+            spikes.append((tick, index))
+    return spikes
+
+
+class TestSpikeSourceArrayCompression(unittest.TestCase):
+
+    def test_per_source_times(self):
+        rng = numpy.random.RandomState(42)
+        spike_times = [
+            list(rng.uniform(0, 1000, rng.randint(0, 20)))
+            for _ in range(300)]
+
+        # A large gap takes more than one halfword, and a source may spike
+        # more than once in a time step
+        spike_times[150].extend([5000000.0, 17.0, 17.0])
+        vertex_slice = _Slice(100, 199)
+
+        expected = sorted(
+            (int(math.ceil((spike_time * 1000.0) / 100)), index)
+            for index in range(vertex_slice.n_atoms)
+            for spike_time in spike_times[vertex_slice.lo_atom + index])
+        stream = compress_spike_times(spike_times, vertex_slice, 100)
+        self.assertEqual(stream.dtype, numpy.uint16)
+        self.assertEqual(_decode(stream), expected)
+        self.assertEqual(
+            get_compressed_spike_times_size(spike_times, vertex_slice, 100),
+            len(stream))
+
+    def test_shared_times(self):
+        vertex_slice = _Slice(0, 3)
+        stream = compress_spike_times([2.0, 0.0, -1.0], vertex_slice, 1000)
+        self.assertEqual(
+            _decode(stream),
+            [(0, 0), (0, 1), (0, 2), (0, 3), (2, 0), (2, 1), (2, 2), (2, 3)])
+
+    def test_no_spikes(self):
+        self.assertEqual(
+            len(compress_spike_times([], _Slice(0, 9), 1000)), 0)
+        self.assertEqual(
+            get_compressed_spike_times_size([], _Slice(0, 9), 1000), 0)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -1,6 +1,12 @@
+import os
+import re
 import unittest
 import spynnaker.pyNN.utilities.constants as constants
 
+PROFILER_H = os.path.join(
+    os.path.dirname(__file__), "..", "..", "neural_modelling", "src",
+    "common", "profiler.h")
+
 
 class TestConstants(unittest.TestCase):
     def test_free_floating_constants(self):
@@ -60,5 +66,21 @@ class TestConstants(unittest.TestCase):
         self.assertEqual(
             constants.POPULATION_BASED_REGIONS.GSYN_HISTORY.value, 9)
 
+    def test_profiler_constants_match_profiler_h(self):
+        with open(PROFILER_H) as profiler_h:
+            source = profiler_h.read()
+        phases = re.search(
+            r"typedef enum profiler_phase \{([^}]*)\}", source).group(1)
+        phases = [phase.strip() for phase in phases.split(",")]
+        self.assertEqual(phases[-1], "PROFILER_N_PHASES")
+        self.assertEqual(len(phases) - 1, len(constants.PROFILER_PHASES))
+
+        n_bins = re.search(r"#define PROFILER_N_BINS (\d+)", source).group(1)
+        self.assertEqual(int(n_bins), constants.PROFILER_N_BINS)
+        self.assertIn(
+            "#define PROFILER_WORDS_PER_PHASE (5 + PROFILER_N_BINS)", source)
+        self.assertEqual(
+            constants.PROFILER_WORDS_PER_PHASE, 5 + constants.PROFILER_N_BINS)
+
 if __name__ == '__main__':
     unittest.main()